@@ -0,0 +1,93 @@
+#include "AllpassBank.h"
+#include <cstdint>
+
+namespace
+{
+    constexpr size_t kCacheLineBytes = SimdLanes::kAlignment;
+
+    // First element of `storage` on a cache-line boundary (storage is over-allocated by a line)
+    template <typename T>
+    T* alignedStart(std::vector<T>& storage)
+    {
+        const auto address = reinterpret_cast<std::uintptr_t>(storage.data());
+        const auto misalignment = address % kCacheLineBytes;
+        return storage.data() + (misalignment == 0 ? 0 : (kCacheLineBytes - misalignment) / sizeof(T));
+    }
+}
+
+template <typename SampleType>
+void AllpassBank<SampleType>::init(const int* maxDelaySamples, int count)
+{
+    constexpr size_t alignSamples = kCacheLineBytes / sizeof(SampleType);
+
+    numStages = count;
+    const auto n = static_cast<size_t>(count);
+
+    lineOffset.assign(n, 0);
+    lineMask.assign(n, 0);
+    delay.assign(n, 1.0f);
+    maxDelay.assign(n, 1.0f);
+    decayGain.assign(n, SampleType(1));
+
+    const size_t paddedStages = (n + alignSamples - 1) / alignSamples * alignSamples;
+    laneStorage.assign(2 * paddedStages + alignSamples, SampleType(0));
+    coefficient = alignedStart(laneStorage);
+    delayed = coefficient + paddedStages;
+    std::fill(coefficient, coefficient + n, SampleType(0.7));
+
+    // Lines are laid out back to back, each starting on a cache line
+    size_t total = 0;
+    for (size_t i = 0; i < n; ++i)
+    {
+        const auto length = static_cast<size_t>(juce::nextPowerOfTwo(maxDelaySamples[i]));
+        lineOffset[i] = total;
+        lineMask[i] = static_cast<juce::uint32>(length - 1);
+        maxDelay[i] = static_cast<float>(length - 2);
+        total += (length + alignSamples - 1) / alignSamples * alignSamples;
+    }
+
+    // Over-allocate by one cache line so the arena itself can start on one
+    storage.assign(total + alignSamples, SampleType(0));
+    arena = alignedStart(storage);
+
+    writeCounter = 0;
+}
+
+template <typename SampleType>
+void AllpassBank<SampleType>::setDelay(int stage, float delaySamples)
+{
+    const auto i = static_cast<size_t>(stage);
+    delay[i] = juce::jlimit(1.0f, static_cast<float>(lineMask[i] + 1) - 4.0f, delaySamples);
+}
+
+template <typename SampleType>
+void AllpassBank<SampleType>::setCoefficient(int stage, SampleType g)
+{
+    coefficient[static_cast<size_t>(stage)] = juce::jlimit(SampleType(-0.99), SampleType(0.99), g);
+}
+
+template <typename SampleType>
+void AllpassBank<SampleType>::setDecayGain(int stage, SampleType gain)
+{
+    decayGain[static_cast<size_t>(stage)] = juce::jlimit(SampleType(0.99), SampleType(1), gain);
+}
+
+template <typename SampleType>
+void AllpassBank<SampleType>::reset()
+{
+    std::fill(storage.begin(), storage.end(), SampleType(0));
+    std::fill(delayed, delayed + numStages, SampleType(0));
+    writeCounter = 0;
+}
+
+template <typename SampleType>
+void AllpassBank<SampleType>::resetStage(int stage)
+{
+    const auto i = static_cast<size_t>(stage);
+    auto* line = arena + lineOffset[i];
+    std::fill(line, line + lineMask[i] + 1, SampleType(0));
+    delayed[i] = SampleType(0);
+}
+
+template class AllpassBank<float>;
+template class AllpassBank<double>;
@@ -0,0 +1,182 @@
+#pragma once
+#include <JuceHeader.h>
+#include "SimdLanes.h"
+#include "StaleRegion.h"
+#include <vector>
+
+// A set of modulated Schroeder allpass stages stored structure-of-arrays: every delay line
+// lives in one contiguous, cache-line aligned arena and the per-stage parameters sit in
+// parallel arrays. Templated on the sample type; instantiated for float and double in
+// AllpassBank.cpp.
+//
+// Each sample runs in three steps:
+//   1. prepareSample() — for every stage at once, the read positions (delay + modulation
+//      offset), the interpolated delayed value and its decay. Nothing here depends on the
+//      current input, so it is one flat loop over all stages.
+//   2. process() — the serial part: a run of consecutive stages in series, each one a
+//      multiply-add on its prepared delayed value plus one store. processLanes() runs
+//      several such chains side by side as SIMD lanes. The run length is a template
+//      argument, so the stage loop has a constant trip count and unrolls.
+//   3. advance() — moves the shared write position on.
+//
+// All lines share one write counter; each line is a power of two long and masks it.
+template <typename SampleType>
+class AllpassBank
+{
+public:
+    AllpassBank() = default;
+
+    static constexpr int kMaxLanes = 16;
+
+    // Allocates the arena for `numStages` lines holding up to maxDelaySamples[i] samples
+    void init(const int* maxDelaySamples, int numStages);
+    int getNumStages() const noexcept { return numStages; }
+
+    void setDelay(int stage, float delaySamples);
+    void setCoefficient(int stage, SampleType g);
+    void setDecayGain(int stage, SampleType gain);
+
+    // Step 1 for the first `count` stages. modOffsets holds one delay offset in samples
+    // per stage (may be nullptr).
+    void prepareSample(const float* modOffsets, int count) noexcept
+    {
+        jassert(count <= numStages);
+        const auto counter = writeCounter;
+        const auto n = static_cast<size_t>(count);
+
+        for (size_t i = 0; i < n; ++i)
+            prepareStage(i, modOffsets != nullptr ? modOffsets[i] : 0.0f, counter);
+    }
+
+    // Step 1 for the lane-major chains of processLanes(), skipping the padding: only lanes
+    // [0, numActive) of each stage are prepared. modOffsets is packed, numActive offsets per
+    // stage. Padding lanes keep the zero delayed value init() and reset() give them.
+    template <int NumStages>
+    void prepareLanes(const float* modOffsets, int firstStage, int numLanes, int numActive) noexcept
+    {
+        jassert(numActive <= numLanes);
+        const auto counter = writeCounter;
+
+        for (int s = 0; s < NumStages; ++s)
+        {
+            const int first = firstStage + s * numLanes;
+            const float* offsets = modOffsets + s * numActive;
+
+            for (int c = 0; c < numActive; ++c)
+                prepareStage(static_cast<size_t>(first + c), offsets[c], counter);
+        }
+    }
+
+    // Step 2. Runs stages [firstStage, firstStage + NumStages) in series on `input`
+    template <int NumStages>
+    SampleType process(int firstStage, SampleType input) noexcept
+    {
+        const auto counter = writeCounter;
+        const auto first = static_cast<size_t>(firstStage);
+
+        for (size_t s = 0; s < static_cast<size_t>(NumStages); ++s)
+        {
+            const auto i = first + s;
+            // Schroeder allpass:
+            //   v[n]   = input + g * v[n-D]     (state variable stored in the line)
+            //   y[n]   = v[n-D] - g * v[n]      (energy-preserving, truly unity gain)
+            const SampleType g = coefficient[i];
+            const SampleType v = input + g * delayed[i];
+            input = delayed[i] - g * v;
+
+            arena[lineOffset[i] + (counter & lineMask[i])] = v;
+        }
+
+        return input;
+    }
+
+    // Step 2 for `numLanes` chains of NumStages stages each, stored lane-major: stage s
+    // of lane c is firstStage + s * numLanes + c. `lanes` holds one input per chain and
+    // receives the outputs. firstStage and numLanes must be multiples of the SIMD width and
+    // `lanes` aligned to SimdLanes::kAlignment. Lanes from numActive on only pad the
+    // registers: they are computed but their lines are never written.
+    template <int NumStages>
+    void processLanes(int firstStage, int numLanes, int numActive, SampleType* lanes) noexcept
+    {
+        using namespace SimdLanes;
+        jassert(numLanes <= kMaxLanes);
+
+        const auto counter = writeCounter;
+        alignas(kAlignment) SampleType states[kMaxLanes];
+
+        for (int s = 0; s < NumStages; ++s)
+        {
+            const int first = firstStage + s * numLanes;
+
+            for (int c = 0; c < numLanes; c += width<SampleType>)
+            {
+                const auto in = load(lanes + c);
+                const auto d = load(delayed + first + c);
+                const auto g = load(coefficient + first + c);
+                const auto v = in + g * d;
+                store(lanes + c, d - g * v);
+                store(states + c, v);
+            }
+
+            // Lines have different lengths, so the state writes stay scalar
+            for (int c = 0; c < numActive; ++c)
+            {
+                const auto i = static_cast<size_t>(first + c);
+                arena[lineOffset[i] + (counter & lineMask[i])] = states[c];
+            }
+        }
+    }
+
+    // Step 3
+    void advance() noexcept { ++writeCounter; }
+
+    void reset();
+    void resetStage(int stage);
+
+    // Write position of every line, for StaleRegion::begin()
+    juce::uint32 getWriteCounter() const noexcept { return writeCounter; }
+
+    // StaleRegion::clearAhead() on the stage's line
+    void clearStaleAhead(int stage, StaleRegion& region, int numSamples, float shortestDelay, float longestDelay) noexcept
+    {
+        const auto i = static_cast<size_t>(stage);
+        region.clearAhead(arena + lineOffset[i], lineMask[i], numSamples, shortestDelay, longestDelay);
+    }
+
+private:
+    // Interpolated, decayed read of stage i's line (step 1 for one stage)
+    void prepareStage(size_t i, float modOffset, juce::uint32 counter) noexcept
+    {
+        const float totalDelay = juce::jlimit(1.0f, maxDelay[i], delay[i] + modOffset);
+
+        const auto delayInt = static_cast<juce::uint32>(totalDelay);
+        const auto frac = static_cast<SampleType>(totalDelay - static_cast<float>(delayInt));
+
+        const SampleType* line = arena + lineOffset[i];
+        const auto mask = lineMask[i];
+        const SampleType s0 = line[(counter - delayInt) & mask];
+        const SampleType s1 = line[(counter - delayInt - 1) & mask];
+
+        // Linear interpolation — reads v[n-D] — with the per-stage decay gain
+        delayed[i] = (s0 + frac * (s1 - s0)) * decayGain[i];
+    }
+
+    std::vector<SampleType> storage;
+    SampleType* arena = nullptr;                // Cache-line aligned start of `storage`
+    std::vector<SampleType> laneStorage;        // Backs coefficient and delayed
+    juce::uint32 writeCounter = 0;
+    int numStages = 0;
+
+    // Per-stage parameters and state, indexed by stage
+    std::vector<size_t> lineOffset;             // Start of the stage's line in the arena
+    std::vector<juce::uint32> lineMask;         // Line length - 1
+    std::vector<float> delay;
+    std::vector<float> maxDelay;                // Longest modulated delay the line can hold
+    std::vector<SampleType> decayGain;
+
+    // Aligned for SIMD loads in processLanes()
+    SampleType* coefficient = nullptr;
+    SampleType* delayed = nullptr;              // Written by prepareSample()
+
+    JUCE_DECLARE_NON_COPYABLE(AllpassBank)
+};
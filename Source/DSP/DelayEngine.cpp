@@ -1,6 +1,17 @@
 #include "DelayEngine.h"
+#include "Smoothing.h"
 
-void DelayEngine::prepare(double sampleRate, int samplesPerBlock)
+namespace
+{
+    constexpr double kFeedbackRampSeconds = 0.05;
+    constexpr double kModDepthRampSeconds = 0.05;
+
+    // Samples per delay line cleared in each sleeping block
+    constexpr size_t kClearSliceSize = 8192;
+}
+
+template <typename SampleType>
+void DelayEngine<SampleType>::prepare(double sampleRate, int samplesPerBlock)
 {
     currentSampleRate = sampleRate;
 
@@ -8,8 +19,8 @@ void DelayEngine::prepare(double sampleRate, int samplesPerBlock)
     int maxDelaySamples = static_cast<int>(sampleRate * 2.0);
     int bufferSize = juce::nextPowerOfTwo(maxDelaySamples);
 
-    delayBufferL.resize(bufferSize, 0.0f);
-    delayBufferR.resize(bufferSize, 0.0f);
+    delayBufferL.resize(bufferSize, SampleType(0));
+    delayBufferR.resize(bufferSize, SampleType(0));
     bufferMask = bufferSize - 1;
 
     writePos = 0;
@@ -27,16 +38,25 @@ void DelayEngine::prepare(double sampleRate, int samplesPerBlock)
     modLfoPhaseR = 0.25f;
     modLfoInc    = 0.0f;
     modDepthSamples = 0.0f;
+
+    feedbackSmoothed.reset(sampleRate, kFeedbackRampSeconds);
+    modDepthSmoothed.reset(sampleRate, kModDepthRampSeconds);
+    modDepthSmoothed.setCurrentAndTargetValue(0.0f);
+    snapSmoothers = true;
+
+    reset();
 }
 
-void DelayEngine::setDelayTime(float timeMs)
+template <typename SampleType>
+void DelayEngine<SampleType>::setDelayTime(float timeMs)
 {
     targetDelaySamples = (timeMs / 1000.0f) * static_cast<float>(currentSampleRate);
     targetDelaySamples = juce::jlimit(1.0f,
         static_cast<float>(delayBufferL.size() - 4), targetDelaySamples);
 }
 
-void DelayEngine::setTempoSync(bool enabled, double bpm, int divisionIndex)
+template <typename SampleType>
+void DelayEngine<SampleType>::setTempoSync(bool enabled, double bpm, int divisionIndex)
 {
     tempoSyncEnabled = enabled;
     if (!enabled || bpm <= 0.0)
@@ -67,125 +87,247 @@ void DelayEngine::setTempoSync(bool enabled, double bpm, int divisionIndex)
     setDelayTime(juce::jlimit(1.0f, 2000.0f, delayMs));
 }
 
-void DelayEngine::setPingPong(bool enabled)
+template <typename SampleType>
+void DelayEngine<SampleType>::setPingPong(bool enabled)
 {
     pingPongEnabled = enabled;
 }
 
-void DelayEngine::setModulation(float rateHz, float depthPercent)
+template <typename SampleType>
+void DelayEngine<SampleType>::setModulation(float rateHz, float depthPercent)
 {
     modLfoInc = rateHz / static_cast<float>(currentSampleRate);
     float maxDepthSamples = static_cast<float>(currentSampleRate) * 0.005f; // 5ms max
     modDepthSamples = maxDepthSamples * (depthPercent / 100.0f);
+    setSmoothedTarget(modDepthSmoothed, modDepthSamples, snapSmoothers);
 }
 
-void DelayEngine::setFeedback(float feedbackPercent)
+template <typename SampleType>
+void DelayEngine<SampleType>::setFeedback(float feedbackPercent)
 {
     feedbackAmount = juce::jlimit(0.0f, 0.95f, feedbackPercent / 100.0f);
+    setSmoothedTarget(feedbackSmoothed, feedbackAmount, snapSmoothers);
 }
 
-void DelayEngine::setHighPassFreq(float hz)
+template <typename SampleType>
+void DelayEngine<SampleType>::setHighPassFreq(float hz)
 {
     highPassL.setCutoff(hz);
     highPassR.setCutoff(hz);
 }
 
-void DelayEngine::setLowPassFreq(float hz)
+template <typename SampleType>
+void DelayEngine<SampleType>::setLowPassFreq(float hz)
 {
     lowPassL.setCutoff(hz);
     lowPassR.setCutoff(hz);
 }
 
-float DelayEngine::cubicHermite(float y0, float y1, float y2, float y3, float frac)
+template <typename SampleType>
+SampleType DelayEngine<SampleType>::cubicHermite(SampleType y0, SampleType y1, SampleType y2, SampleType y3, SampleType frac)
 {
-    float c0 = y1;
-    float c1 = 0.5f * (y2 - y0);
-    float c2 = y0 - 2.5f * y1 + 2.0f * y2 - 0.5f * y3;
-    float c3 = 0.5f * (y3 - y0) + 1.5f * (y1 - y2);
+    const SampleType half = SampleType(0.5);
+    SampleType c0 = y1;
+    SampleType c1 = half * (y2 - y0);
+    SampleType c2 = y0 - SampleType(2.5) * y1 + SampleType(2) * y2 - half * y3;
+    SampleType c3 = half * (y3 - y0) + SampleType(1.5) * (y1 - y2);
     return ((c3 * frac + c2) * frac + c1) * frac + c0;
 }
 
-void DelayEngine::process(juce::AudioBuffer<float>& buffer)
+template <typename SampleType>
+template <bool IsStereo>
+void DelayEngine<SampleType>::render(SampleType* leftData, SampleType* rightData, int numSamples)
 {
-    const int numSamples  = buffer.getNumSamples();
-    const int numChannels = buffer.getNumChannels();
-    if (numChannels == 0) return;
+    // Read with cubic Hermite interpolation
+    auto readWithInterp = [&](const std::vector<SampleType>& buf, float delay) -> SampleType {
+        SampleType readPos = static_cast<SampleType>(writePos) - static_cast<SampleType>(delay);
+        if (readPos < SampleType(0)) readPos += static_cast<SampleType>(buf.size());
+        int rdIdx = static_cast<int>(readPos);
+        SampleType frac = readPos - static_cast<SampleType>(rdIdx);
+        return cubicHermite(
+            buf[(rdIdx - 1) & bufferMask],
+            buf[ rdIdx      & bufferMask],
+            buf[(rdIdx + 1) & bufferMask],
+            buf[(rdIdx + 2) & bufferMask],
+            frac);
+    };
 
-    auto* leftData  = buffer.getWritePointer(0);
-    auto* rightData = numChannels > 1 ? buffer.getWritePointer(1) : leftData;
+    const float maxDelay = static_cast<float>(delayBufferL.size() - 4);
 
     for (int i = 0; i < numSamples; ++i)
     {
         // Smooth delay time (prevents clicks on tempo-sync jumps, τ ≈ 42ms @ 44100Hz)
         smoothedDelaySamples += (1.0f - kSmoothCoeff) * (targetDelaySamples - smoothedDelaySamples);
 
+        // Per-sample ramps for feedback and modulation depth (automation-safe at any block size)
+        const float feedback = feedbackSmoothed.getNextValue();
+        const float modDepth = modDepthSmoothed.getNextValue();
+
         // Per-channel LFO modulation offsets (normalized phase [0,1))
-        float modOffsetL = modDepthSamples *
+        float modOffsetL = modDepth *
             std::sin(2.0f * juce::MathConstants<float>::pi * modLfoPhaseL);
-        float modOffsetR = modDepthSamples *
-            std::sin(2.0f * juce::MathConstants<float>::pi * modLfoPhaseR);
-
         modLfoPhaseL += modLfoInc;
-        modLfoPhaseR += modLfoInc;
         if (modLfoPhaseL >= 1.0f) modLfoPhaseL -= 1.0f;
-        if (modLfoPhaseR >= 1.0f) modLfoPhaseR -= 1.0f;
-
-        float effectiveDelayL = juce::jlimit(1.0f,
-            static_cast<float>(delayBufferL.size() - 4),
-            smoothedDelaySamples + modOffsetL);
-        float effectiveDelayR = juce::jlimit(1.0f,
-            static_cast<float>(delayBufferR.size() - 4),
-            smoothedDelaySamples + modOffsetR);
-
-        // Read with cubic Hermite interpolation
-        auto readWithInterp = [&](const std::vector<float>& buf, float delay) -> float {
-            float readPos = static_cast<float>(writePos) - delay;
-            if (readPos < 0.0f) readPos += static_cast<float>(buf.size());
-            int rdIdx = static_cast<int>(readPos);
-            float frac = readPos - static_cast<float>(rdIdx);
-            return cubicHermite(
-                buf[(rdIdx - 1) & bufferMask],
-                buf[ rdIdx      & bufferMask],
-                buf[(rdIdx + 1) & bufferMask],
-                buf[(rdIdx + 2) & bufferMask],
-                frac);
-        };
-
-        float delayedL = readWithInterp(delayBufferL, effectiveDelayL);
-        float delayedR = readWithInterp(delayBufferR, effectiveDelayR);
+
+        float effectiveDelayL = juce::jlimit(1.0f, maxDelay, smoothedDelaySamples + modOffsetL);
+        SampleType delayedL = readWithInterp(delayBufferL, effectiveDelayL);
 
         // Feedback path filters: HP then LP
         delayedL = lowPassL.processSample(highPassL.processSample(delayedL));
-        delayedR = lowPassR.processSample(highPassR.processSample(delayedR));
 
-        // Write input + feedback to delay buffer
-        if (pingPongEnabled)
+        if constexpr (IsStereo)
         {
-            // Input is summed to mono and enters ONLY the L buffer.
-            // R buffer receives ONLY the cross-fed feedback from L (no direct input).
-            // This forces echoes to alternate strictly: L → R → L → R ...
-            float monoIn = (leftData[i] + rightData[i]) * 0.5f;
-            delayBufferL[writePos] = monoIn        + delayedR * feedbackAmount;
-            delayBufferR[writePos] = delayedL      * feedbackAmount;
+            float modOffsetR = modDepth *
+                std::sin(2.0f * juce::MathConstants<float>::pi * modLfoPhaseR);
+            modLfoPhaseR += modLfoInc;
+            if (modLfoPhaseR >= 1.0f) modLfoPhaseR -= 1.0f;
+
+            float effectiveDelayR = juce::jlimit(1.0f, maxDelay, smoothedDelaySamples + modOffsetR);
+            SampleType delayedR = readWithInterp(delayBufferR, effectiveDelayR);
+            delayedR = lowPassR.processSample(highPassR.processSample(delayedR));
+
+            // Write input + feedback to delay buffer
+            if (pingPongEnabled)
+            {
+                // Input is summed to mono and enters ONLY the L buffer.
+                // R buffer receives ONLY the cross-fed feedback from L (no direct input).
+                // This forces echoes to alternate strictly: L → R → L → R ...
+                SampleType monoIn = (leftData[i] + rightData[i]) * SampleType(0.5);
+                delayBufferL[writePos] = monoIn        + delayedR * feedback;
+                delayBufferR[writePos] = delayedL      * feedback;
+            }
+            else
+            {
+                delayBufferL[writePos] = leftData[i]  + delayedL * feedback;
+                delayBufferR[writePos] = rightData[i] + delayedR * feedback;
+            }
+
+            // Output is the delayed signal
+            leftData[i]  = delayedL;
+            rightData[i] = delayedR;
         }
         else
         {
-            delayBufferL[writePos] = leftData[i]  + delayedL * feedbackAmount;
-            delayBufferR[writePos] = rightData[i] + delayedR * feedbackAmount;
+            // Mono: ping-pong echoes would all land in the same channel anyway
+            delayBufferL[writePos] = leftData[i] + delayedL * feedback;
+            leftData[i] = delayedL;
         }
 
-        // Output is the delayed signal
-        leftData[i]  = delayedL;
-        rightData[i] = delayedR;
-
         writePos = (writePos + 1) & static_cast<int>(bufferMask);
     }
 }
 
-void DelayEngine::reset()
+template <typename SampleType>
+void DelayEngine<SampleType>::process(juce::AudioBuffer<SampleType>& buffer)
+{
+    const int numSamples  = buffer.getNumSamples();
+    const int numChannels = buffer.getNumChannels();
+    if (numChannels == 0) return;
+
+    const bool inputSilent = SilenceDetector::isSilent(buffer);
+
+    if (sleeping)
+    {
+        if (inputSilent)
+        {
+            // Nothing in and nothing left to echo — output silence and keep tidying up
+            skipSmoothing();
+            clearNextSlice();
+            buffer.clear();
+            return;
+        }
+
+        wakeUp();
+    }
+
+    // Mono output runs a single delay line (ping-pong collapses to plain echoes in mono)
+    if (numChannels > 1)
+        render<true>(buffer.getWritePointer(0), buffer.getWritePointer(1), numSamples);
+    else
+        render<false>(buffer.getWritePointer(0), nullptr, numSamples);
+
+    snapSmoothers = false;
+
+    // Anything that can still be read back was written within the last (longest) delay
+    // period, so once that much input and output has been silent the lines hold nothing audible
+    const float longestDelay = std::max(smoothedDelaySamples, targetDelaySamples) + modDepthSamples;
+    silenceDetector.setHoldSamples(static_cast<int>(longestDelay) + 4);
+
+    if (silenceDetector.update(inputSilent, buffer))
+        enterSleep();
+}
+
+template <typename SampleType>
+double DelayEngine<SampleType>::getTailLengthSeconds() const
+{
+    // Every repeat is one delay period later and `feedbackAmount` quieter (the HP/LP
+    // filters only remove more), so count repeats down to the sleep threshold.
+    const float period = targetDelaySamples + modDepthSamples;
+    float repeats = 0.0f;
+    if (feedbackAmount > 1.0e-6f)
+        repeats = SilenceDetector::kThresholdDb / (20.0f * std::log10(feedbackAmount));
+
+    return static_cast<double>(period * (1.0f + repeats)) / currentSampleRate;
+}
+
+template <typename SampleType>
+void DelayEngine<SampleType>::enterSleep()
+{
+    sleeping = true;
+    clearPending = true;
+    clearPos = 0;
+    silenceDetector.reset();
+}
+
+template <typename SampleType>
+void DelayEngine<SampleType>::wakeUp()
+{
+    // Whatever is left to clear has to go now, before new input is written
+    while (!clearNextSlice()) {}
+
+    sleeping = false;
+    silenceDetector.reset();
+}
+
+template <typename SampleType>
+bool DelayEngine<SampleType>::clearNextSlice()
 {
-    std::fill(delayBufferL.begin(), delayBufferL.end(), 0.0f);
-    std::fill(delayBufferR.begin(), delayBufferR.end(), 0.0f);
+    if (!clearPending)
+        return true;
+
+    const size_t end = std::min(delayBufferL.size(), clearPos + kClearSliceSize);
+    std::fill(delayBufferL.begin() + static_cast<std::ptrdiff_t>(clearPos),
+              delayBufferL.begin() + static_cast<std::ptrdiff_t>(end), SampleType(0));
+    std::fill(delayBufferR.begin() + static_cast<std::ptrdiff_t>(clearPos),
+              delayBufferR.begin() + static_cast<std::ptrdiff_t>(end), SampleType(0));
+    clearPos = end;
+
+    if (clearPos < delayBufferL.size())
+        return false;
+
+    highPassL.reset();
+    highPassR.reset();
+    lowPassL.reset();
+    lowPassR.reset();
+    clearPending = false;
+    return true;
+}
+
+template <typename SampleType>
+void DelayEngine<SampleType>::skipSmoothing()
+{
+    // Nothing is audible while asleep, so parameter ramps can jump to their targets
+    smoothedDelaySamples = targetDelaySamples;
+    feedbackSmoothed.setCurrentAndTargetValue(feedbackSmoothed.getTargetValue());
+    modDepthSmoothed.setCurrentAndTargetValue(modDepthSmoothed.getTargetValue());
+    snapSmoothers = false;
+}
+
+template <typename SampleType>
+void DelayEngine<SampleType>::reset()
+{
+    std::fill(delayBufferL.begin(), delayBufferL.end(), SampleType(0));
+    std::fill(delayBufferR.begin(), delayBufferR.end(), SampleType(0));
     writePos = 0;
 
     highPassL.reset();
@@ -196,4 +338,13 @@ void DelayEngine::reset()
     smoothedDelaySamples = 0.0f;
     modLfoPhaseL = 0.0f;
     modLfoPhaseR = 0.25f;
+
+    // Everything is clear, so start asleep until the first non-silent block
+    sleeping = true;
+    clearPending = false;
+    clearPos = 0;
+    silenceDetector.reset();
 }
+
+template class DelayEngine<float>;
+template class DelayEngine<double>;
@@ -1,7 +1,11 @@
 #pragma once
 #include <JuceHeader.h>
 #include "FilterUtils.h"
+#include "SilenceDetector.h"
 
+// Templated on the audio sample type; instantiated for float and double in DelayEngine.cpp.
+// Delay times and control values stay float, the delay lines and filters run at SampleType.
+template <typename SampleType>
 class DelayEngine
 {
 public:
@@ -15,14 +19,32 @@ public:
     void setTempoSync(bool enabled, double bpm, int divisionIndex);
     void setPingPong(bool enabled);
     void setModulation(float rateHz, float depthPercent);
-    void process(juce::AudioBuffer<float>& buffer);
+    void process(juce::AudioBuffer<SampleType>& buffer);
     void reset();
 
+    // True while the engine is idle on silence (see process())
+    bool isSleeping() const noexcept { return sleeping; }
+
+    // Estimated time for the echoes to decay below the sleep threshold after the
+    // input stops, from the current delay time and feedback
+    double getTailLengthSeconds() const;
+
 private:
-    float cubicHermite(float y0, float y1, float y2, float y3, float frac);
+    SampleType cubicHermite(SampleType y0, SampleType y1, SampleType y2, SampleType y3, SampleType frac);
+
+    // Per-sample loop; the mono variant runs only the left delay line
+    template <bool IsStereo>
+    void render(SampleType* leftData, SampleType* rightData, int numSamples);
 
-    std::vector<float> delayBufferL;
-    std::vector<float> delayBufferR;
+    // Sleep on silence: once input and echoes have died away the engine stops
+    // running and clears its delay lines one slice per sleeping block
+    void enterSleep();
+    void wakeUp();
+    bool clearNextSlice();
+    void skipSmoothing();
+
+    std::vector<SampleType> delayBufferL;
+    std::vector<SampleType> delayBufferR;
     size_t bufferMask = 0;
     int writePos = 0;
 
@@ -45,8 +67,19 @@ private:
     float smoothedDelaySamples = 0.0f;
     static constexpr float kSmoothCoeff = 0.9995f;
 
-    HighPassFilter highPassL;
-    HighPassFilter highPassR;
-    LowPassFilter lowPassL;
-    LowPassFilter lowPassR;
+    // Per-sample linear ramps for the cheap gain-like parameters
+    // (targets live in feedbackAmount / modDepthSamples)
+    juce::SmoothedValue<float> feedbackSmoothed;
+    juce::SmoothedValue<float> modDepthSmoothed;
+    bool snapSmoothers = true;     // Setters jump to target until the first process() after prepare()
+
+    SilenceDetector silenceDetector;
+    bool sleeping = false;
+    bool clearPending = false;     // Delay lines still hold (sub-threshold) data
+    size_t clearPos = 0;           // Next sample to clear while asleep
+
+    HighPassFilter<SampleType> highPassL;
+    HighPassFilter<SampleType> highPassR;
+    LowPassFilter<SampleType> lowPassL;
+    LowPassFilter<SampleType> lowPassR;
 };
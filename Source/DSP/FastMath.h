@@ -0,0 +1,32 @@
+#pragma once
+#include <JuceHeader.h>
+
+// Cheap stand-ins for transcendental functions on per-sample paths. Header-only so they
+// inline into the engine loops.
+namespace FastMath
+{
+    // Largest |x| fed to the tanh approximant; beyond it tanh(x) is 1 to within 2e-6
+    constexpr double kTanhInputLimit = 7.0;
+
+    // tanh(x) from the [9/8] Padé approximant (Lambert's continued fraction), with the
+    // input clamped to ±kTanhInputLimit and the result to ±1.
+    //
+    // Maximum absolute error of the approximant against std::tanh over the whole real line:
+    // 6.8e-6 (at |x| ≈ 6.3, where the output is saturated anyway). For |x| < 2, where the
+    // reverb input spends nearly all its time, it is 2.1e-12. In float the rounding of the
+    // result (up to 2 ulp, 2.4e-7) comes on top. tools/fastmath_tests holds it to these bounds.
+    // Only multiplies, adds, one divide and min/max — no branches or tables — so it maps
+    // directly onto SIMD lanes.
+    template <typename T>
+    inline T tanh(T x) noexcept
+    {
+        const T limit = static_cast<T>(kTanhInputLimit);
+        x = juce::jlimit(-limit, limit, x);
+
+        const T x2 = x * x;
+        const T num = x * (T(34459425) + x2 * (T(4729725) + x2 * (T(135135) + x2 * (T(990) + x2))));
+        const T den = T(34459425) + x2 * (T(16216200) + x2 * (T(945945) + x2 * (T(13860) + x2 * T(45))));
+
+        return juce::jlimit(T(-1), T(1), num / den);
+    }
+}
@@ -0,0 +1,572 @@
+#include "FdnReverbEngine.h"
+#include "Smoothing.h"
+#include "FastMath.h"
+
+namespace
+{
+    // Ramp lengths for the smoothed parameters (as in ReverbEngine)
+    constexpr double kSizeRampSeconds     = 0.1;
+    constexpr double kGravityRampSeconds  = 0.1;
+    constexpr double kFeedbackRampSeconds = 0.05;
+
+    // Pre-delay samples cleared in each sleeping block (lines go one per block)
+    constexpr size_t kClearSliceSize = 8192;
+
+    // Decay time range over the Feedback control, and the per-pass gain while frozen
+    // (lossless apart from a margin against rounding build-up)
+    constexpr float kMinDecaySeconds = 0.3f;
+    constexpr float kMaxDecaySeconds = 6.0f;
+    constexpr double kFreezeGain = 0.99995;
+
+    // Headroom in each line for the modulation swing and interpolation
+    constexpr int kModulationMargin = 16;
+}
+
+template <typename SampleType, int NumLines>
+void FdnReverbEngine<SampleType, NumLines>::prepare(double sampleRate, int samplesPerBlock, int numOutputChannels)
+{
+    jassert(numOutputChannels <= kMaxOutputChannels);
+    numChains = juce::jlimit(1, kMaxOutputChannels, numOutputChannels);
+    currentSampleRate = sampleRate;
+    sampleRateScale = static_cast<float>(sampleRate / 44100.0);
+
+    // Lines back to back, long enough for the largest Size plus the modulation swing
+    size_t total = 0;
+    for (int i = 0; i < NumLines; ++i)
+    {
+        const int longest = static_cast<int>(baseDelay(i) * sampleRateScale * 1.3f) + kModulationMargin;
+        const auto length = static_cast<size_t>(juce::nextPowerOfTwo(longest));
+        lineOffset[i] = total;
+        lineMask[i] = static_cast<juce::uint32>(length - 1);
+        maxLineDelay[i] = static_cast<float>(length - 2);
+        total += length;
+    }
+    lineStorage.assign(total, SampleType(0));
+
+    // Input spread over every line at equal power, signs alternating in a fixed pattern
+    // so the lines do not start in phase
+    const SampleType inputScale = SampleType(1) / std::sqrt(static_cast<SampleType>(NumLines));
+    for (int i = 0; i < NumLines; ++i)
+        inputGain[i] = ((i * 5 + 3) & 4) != 0 ? -inputScale : inputScale;
+
+    // Row 0 of the Hadamard matrix is all ones (the same sum for every output), so
+    // outputs use rows 1 and up; beyond NumLines - 1 outputs each also blends the next row
+    const int numRows = NumLines - 1;
+    for (int c = 0; c < kMaxOutputChannels; ++c)
+    {
+        outputRow[c] = 1 + c % numRows;
+        outputPartner[c] = c < numRows ? -1 : 1 + (c + 1) % numRows;
+    }
+
+    float phases[NumLines];
+    for (int i = 0; i < NumLines; ++i)
+        phases[i] = (juce::MathConstants<float>::twoPi * i) / NumLines;
+    lfos.init(phases, NumLines);
+
+    // Pre-delay buffer
+    int preDelaySize = juce::nextPowerOfTwo(kMaxPreDelaySamples);
+    preDelayBuffer.resize(preDelaySize, 0.0f);
+    preDelayMask = preDelaySize - 1;
+    preDelayWritePos = 0;
+
+    filters.prepare(sampleRate);
+
+    sizeSmoothed.reset(sampleRate, kSizeRampSeconds);
+    gravitySmoothed.reset(sampleRate, kGravityRampSeconds);
+    feedbackSmoothed.reset(sampleRate, kFeedbackRampSeconds);
+    snapSmoothers = true;
+
+    applySize(currentSize);
+    lineGainsDirty = true;
+    updateLineGains();
+
+    reset();
+}
+
+template <typename SampleType, int NumLines>
+void FdnReverbEngine<SampleType, NumLines>::setGravity(float gravity)
+{
+    currentGravity = gravity;
+    setSmoothedTarget(gravitySmoothed, gravity, snapSmoothers);
+    lineGainsDirty = true;
+}
+
+template <typename SampleType, int NumLines>
+void FdnReverbEngine<SampleType, NumLines>::setSize(float size)
+{
+    float scaleFactor = juce::jlimit(0.05f, 1.3f, size / 100.0f);
+    if (scaleFactor == currentSize)
+        return;
+
+    currentSize = scaleFactor;
+    setSmoothedTarget(sizeSmoothed, scaleFactor, snapSmoothers);
+    if (snapSmoothers)
+        applySize(scaleFactor);
+}
+
+template <typename SampleType, int NumLines>
+void FdnReverbEngine<SampleType, NumLines>::applySize(float scaleFactor)
+{
+    for (int i = 0; i < NumLines; ++i)
+        lineDelay[i] = juce::jlimit(1.0f, maxLineDelay[i] - kModulationMargin,
+                                    baseDelay(i) * sampleRateScale * scaleFactor);
+
+    // The gain per pass follows the line length
+    lineGainsDirty = true;
+}
+
+template <typename SampleType, int NumLines>
+void FdnReverbEngine<SampleType, NumLines>::setPreDelay(float ms)
+{
+    preDelaySamples = juce::jlimit(0.0f, static_cast<float>(kMaxPreDelaySamples - 1),
+                                   (ms / 1000.0f) * static_cast<float>(currentSampleRate));
+}
+
+template <typename SampleType, int NumLines>
+void FdnReverbEngine<SampleType, NumLines>::setFeedback(float percent)
+{
+    float amount = ReverbEqSettings::feedbackPercentToAmount(percent);
+    if (amount == feedbackAmount)
+        return;
+
+    feedbackAmount = amount;
+    setSmoothedTarget(feedbackSmoothed, amount, snapSmoothers);
+    filters.setFeedbackAmount(amount);
+    lineGainsDirty = true;
+}
+
+template <typename SampleType, int NumLines>
+void FdnReverbEngine<SampleType, NumLines>::setModulation(float depthPercent, float rateHz)
+{
+    modDepthSamples = juce::jmap(depthPercent, 0.0f, 100.0f, 0.0f, 12.0f);
+    lfos.setPhaseIncrement((rateHz * juce::MathConstants<float>::twoPi) / static_cast<float>(currentSampleRate));
+}
+
+template <typename SampleType, int NumLines>
+float FdnReverbEngine<SampleType, NumLines>::decaySeconds() const
+{
+    // Feedback sets the decay time, Gravity stretches it (x2 at +100, x0.5 at -100) and
+    // a larger room rings a little longer
+    const float feedback = feedbackSmoothed.getCurrentValue() / 0.85f;
+    const float gravity = gravitySmoothed.getCurrentValue();
+    const float size = sizeSmoothed.getCurrentValue();
+
+    return juce::jmap(feedback, kMinDecaySeconds, kMaxDecaySeconds)
+         * std::exp2(gravity / 100.0f) * std::sqrt(size);
+}
+
+template <typename SampleType, int NumLines>
+void FdnReverbEngine<SampleType, NumLines>::updateLineGains()
+{
+    // -60 dB after decaySeconds: each pass through a line of L samples loses
+    // 60 * L / (T60 * sampleRate) dB
+    const double samplesFor60dB = static_cast<double>(decaySeconds()) * currentSampleRate;
+
+    for (int i = 0; i < NumLines; ++i)
+        lineGain[i] = static_cast<SampleType>(std::pow(10.0, -3.0 * lineDelay[i] / samplesFor60dB));
+
+    lineGainsDirty = false;
+}
+
+template <typename SampleType, int NumLines>
+void FdnReverbEngine<SampleType, NumLines>::updateControlRate(int numSamples)
+{
+    if (sizeSmoothed.isSmoothing())
+        applySize(sizeSmoothed.skip(numSamples));
+
+    if (gravitySmoothed.isSmoothing())
+    {
+        gravitySmoothed.skip(numSamples);
+        lineGainsDirty = true;
+    }
+
+    if (feedbackSmoothed.isSmoothing())
+    {
+        feedbackSmoothed.skip(numSamples);
+        lineGainsDirty = true;
+    }
+
+    if (lineGainsDirty)
+        updateLineGains();
+}
+
+template <typename SampleType, int NumLines>
+void FdnReverbEngine<SampleType, NumLines>::mixLines(SampleType* lanes) noexcept
+{
+    using namespace SimdLanes;
+    constexpr int kWidth = width<SampleType>;
+
+    // Fast Walsh-Hadamard transform: log2(NumLines) rounds of butterflies across the lines
+    for (int half = 1; half < NumLines; half *= 2)
+    {
+        for (int i = 0; i < NumLines; i += 2 * half)
+        {
+            if (half >= kWidth)
+            {
+                // Both halves of the butterfly are whole registers
+                for (int j = i; j < i + half; j += kWidth)
+                {
+                    const auto a = load(lanes + j);
+                    const auto b = load(lanes + j + half);
+                    store(lanes + j, a + b);
+                    store(lanes + j + half, a - b);
+                }
+            }
+            else
+            {
+                // Pairs closer than a register apart stay scalar
+                for (int j = i; j < i + half; ++j)
+                {
+                    const SampleType a = lanes[j];
+                    const SampleType b = lanes[j + half];
+                    lanes[j] = a + b;
+                    lanes[j + half] = a - b;
+                }
+            }
+        }
+    }
+
+    // Orthonormal scaling keeps the mix lossless
+    const auto scale = broadcast(SampleType(1) / std::sqrt(static_cast<SampleType>(NumLines)));
+    for (int i = 0; i < NumLines; i += kWidth)
+        store(lanes + i, load(lanes + i) * scale);
+}
+
+template <typename SampleType, int NumLines>
+void FdnReverbEngine<SampleType, NumLines>::feedLines(SampleType* lanes, SampleType input) noexcept
+{
+    using namespace SimdLanes;
+    constexpr int kWidth = width<SampleType>;
+    const auto in = broadcast(input);
+
+    if (isFrozen)
+    {
+        const auto gain = broadcast(static_cast<SampleType>(kFreezeGain));
+        for (int i = 0; i < NumLines; i += kWidth)
+            store(lanes + i, load(lanes + i) * gain + load(inputGain + i) * in);
+    }
+    else
+    {
+        for (int i = 0; i < NumLines; i += kWidth)
+            store(lanes + i, load(lanes + i) * load(lineGain + i) + load(inputGain + i) * in);
+    }
+}
+
+template <typename SampleType, int NumLines>
+SampleType FdnReverbEngine<SampleType, NumLines>::tapOutput(int channel, const SampleType* mixed) const noexcept
+{
+    const SampleType row = mixed[outputRow[channel]];
+    if (outputPartner[channel] < 0)
+        return row;
+
+    return (row - mixed[outputPartner[channel]]) * SampleType(0.70710678118654752);
+}
+
+template <typename SampleType, int NumLines>
+void FdnReverbEngine<SampleType, NumLines>::render(SampleType* const* channels, int numOutputs, int numSamples)
+{
+    const SampleType outputScale = SampleType(1) / static_cast<SampleType>(numOutputs);
+    const int numOutputLanes = SimdLanes::paddedLanes<SampleType>(numOutputs);
+
+    // One sample per line, then one per output channel
+    alignas(SimdLanes::kAlignment) SampleType lanes[NumLines];
+    alignas(SimdLanes::kAlignment) SampleType outputs[kMaxLanes] {};
+
+    for (int blockStart = 0; blockStart < numSamples; blockStart += kControlBlockSize)
+    {
+        const int blockEnd = std::min(numSamples, blockStart + kControlBlockSize);
+        updateControlRate(blockEnd - blockStart);
+        lfos.advance(blockEnd - blockStart, NumLines);
+
+        for (int n = blockStart; n < blockEnd; ++n)
+        {
+            // 1. Sum the input channels to mono; Freeze kills new input
+            SampleType monoIn = channels[0][n];
+            for (int c = 1; c < numOutputs; ++c)
+                monoIn += channels[c][n];
+            if (numOutputs > 1)
+                monoIn *= outputScale;
+            if (isFrozen)
+                monoIn = SampleType(0);
+
+            // 2. Soft-clip the input (tanh to within 7e-6, see FastMath)
+            monoIn = FastMath::tanh(monoIn);
+
+            // 3. Pre-delay
+            preDelayBuffer[preDelayWritePos & preDelayMask] = monoIn;
+            int delayOffset = static_cast<int>(preDelaySamples);
+            int readIdx = (preDelayWritePos - delayOffset + static_cast<int>(preDelayBuffer.size())) & preDelayMask;
+            monoIn = preDelayBuffer[readIdx];
+            preDelayWritePos = (preDelayWritePos + 1) & preDelayMask;
+
+            // 4. Modulated, linearly interpolated read of every line
+            lfos.render(modOffsets, NumLines, isFrozen ? 0.0f : modDepthSamples);
+            const auto counter = writeCounter;
+            for (int i = 0; i < NumLines; ++i)
+            {
+                const float totalDelay = juce::jlimit(1.0f, maxLineDelay[i], lineDelay[i] + modOffsets[i]);
+                const auto delayInt = static_cast<juce::uint32>(totalDelay);
+                const auto frac = static_cast<SampleType>(totalDelay - static_cast<float>(delayInt));
+
+                const SampleType* line = lineStorage.data() + lineOffset[i];
+                const SampleType s0 = line[(counter - delayInt) & lineMask[i]];
+                const SampleType s1 = line[(counter - delayInt - 1) & lineMask[i]];
+                lanes[i] = s0 + frac * (s1 - s0);
+            }
+
+            // 5. Per-line damping and EQ (Freeze bypasses all damping)
+            if (!isFrozen)
+                filters.processFeedback(lanes, NumLines);
+
+            // 6. Mix, tap the outputs, then feed back with the decay gain plus the input
+            mixLines(lanes);
+
+            for (int c = 0; c < numOutputs; ++c)
+                outputs[c] = tapOutput(c, lanes);
+
+            feedLines(lanes, monoIn);
+
+            for (int i = 0; i < NumLines; ++i)
+                lineStorage[lineOffset[i] + (counter & lineMask[i])] = lanes[i];
+
+            ++writeCounter;
+
+            // 7. Output EQ (boost only — outside the loop)
+            std::copy(outputs, outputs + numOutputs, feedbackTap);
+            filters.processOutput(outputs, numOutputLanes);
+
+            for (int c = 0; c < numOutputs; ++c)
+            {
+                // 8. Safety clamp + NaN protection
+                SampleType out = std::clamp(outputs[c], SampleType(-4), SampleType(4));
+                if (std::isnan(out) || std::isinf(out)) out = SampleType(0);
+                out += SampleType(1e-25);  // denormal prevention
+
+                channels[c][n] = out;
+            }
+        }
+    }
+}
+
+template <typename SampleType, int NumLines>
+void FdnReverbEngine<SampleType, NumLines>::process(juce::AudioBuffer<SampleType>& buffer)
+{
+    const int numSamples  = buffer.getNumSamples();
+    const int numChannels = buffer.getNumChannels();
+
+    if (numChannels == 0)
+        return;
+
+    const bool inputSilent = SilenceDetector::isSilent(buffer);
+
+    if (sleeping)
+    {
+        if (inputSilent)
+        {
+            // Tail has died away and nothing new is coming in — output silence and keep tidying up
+            skipSmoothing();
+            clearNextSlice();
+            buffer.clear();
+            return;
+        }
+
+        wakeUp();
+    }
+
+    // Channels beyond the prepared count stay silent
+    jassert(numChannels <= numChains);
+    const int outputs = std::min(numChannels, numChains);
+    for (int ch = outputs; ch < numChannels; ++ch)
+        buffer.clear(ch, 0, numSamples);
+
+    if (clearingStale)
+        clearStaleAhead(numSamples);
+
+    render(buffer.getArrayOfWritePointers(), outputs, numSamples);
+
+    snapSmoothers = false;
+
+    // A frozen tail never decays, so only a free-running one may go to sleep
+    silenceDetector.setHoldSamples(longestPathSamples());
+    if (silenceDetector.update(inputSilent, buffer) && !isFrozen && sleepEnabled)
+        enterSleep();
+}
+
+template <typename SampleType, int NumLines>
+int FdnReverbEngine<SampleType, NumLines>::longestPathSamples() const
+{
+    float longest = 0.0f;
+    for (int i = 0; i < NumLines; ++i)
+        longest = std::max(longest, lineDelay[i]);
+
+    return static_cast<int>(preDelaySamples + longest + modDepthSamples) + kControlBlockSize;
+}
+
+template <typename SampleType, int NumLines>
+double FdnReverbEngine<SampleType, NumLines>::getTailLengthSeconds() const
+{
+    if (isFrozen)
+        return std::numeric_limits<double>::infinity();
+
+    // Decay range to cover: down to the sleep threshold, plus whatever the output filters add
+    const float rangeDb = -SilenceDetector::kThresholdDb + filters.getOutputBoostDb();
+
+    // From the targets rather than the smoothers, which may still be moving
+    const float decay = juce::jmap(feedbackAmount / 0.85f, kMinDecaySeconds, kMaxDecaySeconds)
+                      * std::exp2(currentGravity / 100.0f) * std::sqrt(currentSize);
+
+    return static_cast<double>(longestPathSamples()) / currentSampleRate
+         + static_cast<double>(decay * rangeDb / 60.0f);
+}
+
+template <typename SampleType, int NumLines>
+void FdnReverbEngine<SampleType, NumLines>::enterSleep()
+{
+    sleeping = true;
+    clearStep = 0;
+    numClearSteps = NumLines
+                  + static_cast<int>((preDelayBuffer.size() + kClearSliceSize - 1) / kClearSliceSize)
+                  + 1;   // Last step resets the filters
+    silenceDetector.reset();
+
+    // The sleeping blocks clear everything from here
+    endStaleRegions();
+}
+
+template <typename SampleType, int NumLines>
+void FdnReverbEngine<SampleType, NumLines>::wakeUp()
+{
+    // Nothing from before is heard again, so ramps set up since the last silent block (or
+    // by ReverbSection bringing a stale engine up to date) can jump to their targets
+    skipSmoothing();
+
+    // The lines and pre-delay slices the sleeping blocks did not get to are cleared ahead
+    // of the reads from here on, so the cost stays with the blocks that read them
+    if (clearStep < numClearSteps)
+    {
+        for (int i = clearStep; i < NumLines; ++i)
+            staleLines[i].begin(writeCounter);
+
+        if (clearStep < numClearSteps - 1)
+            stalePreDelay.begin(static_cast<juce::uint32>(preDelayWritePos));
+
+        filters.reset();
+        std::fill(std::begin(feedbackTap), std::end(feedbackTap), SampleType(0));
+
+        clearStep = numClearSteps;
+        clearingStale = true;
+    }
+
+    sleeping = false;
+    silenceDetector.reset();
+}
+
+template <typename SampleType, int NumLines>
+void FdnReverbEngine<SampleType, NumLines>::clearStaleAhead(int numSamples)
+{
+    // Size ramps towards its target over the block; the lines read anywhere between the
+    // lengths at its start and end, give or take the modulation
+    auto sizeAtEnd = sizeSmoothed;
+    const float sizeFrom = sizeSmoothed.getCurrentValue();
+    const float sizeTo = sizeAtEnd.skip(numSamples);
+    const float shortest = std::min(sizeFrom, sizeTo) * sampleRateScale;
+    const float longest = std::max(sizeFrom, sizeTo) * sampleRateScale;
+
+    bool stale = false;
+    for (int i = 0; i < NumLines; ++i)
+    {
+        if (!staleLines[i].isActive())
+            continue;
+
+        const float base = static_cast<float>(baseDelay(i));
+        staleLines[i].clearAhead(lineStorage.data() + lineOffset[i], lineMask[i], numSamples,
+                                 base * shortest - modDepthSamples, base * longest + modDepthSamples);
+        stale = stale || staleLines[i].isActive();
+    }
+
+    stalePreDelay.clearAhead(preDelayBuffer.data(), static_cast<juce::uint32>(preDelayMask), numSamples,
+                             preDelaySamples, preDelaySamples);
+
+    clearingStale = stale || stalePreDelay.isActive();
+}
+
+template <typename SampleType, int NumLines>
+void FdnReverbEngine<SampleType, NumLines>::endStaleRegions()
+{
+    for (auto& region : staleLines)
+        region.end();
+
+    stalePreDelay.end();
+    clearingStale = false;
+}
+
+template <typename SampleType, int NumLines>
+bool FdnReverbEngine<SampleType, NumLines>::clearNextSlice()
+{
+    if (clearStep >= numClearSteps)
+        return true;
+
+    const int step = clearStep++;
+
+    if (step < NumLines)
+    {
+        auto line = lineStorage.begin() + static_cast<std::ptrdiff_t>(lineOffset[step]);
+        std::fill(line, line + static_cast<std::ptrdiff_t>(lineMask[step] + 1), SampleType(0));
+    }
+    else if (step < numClearSteps - 1)
+    {
+        const size_t start = static_cast<size_t>(step - NumLines) * kClearSliceSize;
+        const size_t end   = std::min(preDelayBuffer.size(), start + kClearSliceSize);
+        std::fill(preDelayBuffer.begin() + static_cast<std::ptrdiff_t>(start),
+                  preDelayBuffer.begin() + static_cast<std::ptrdiff_t>(end), 0.0f);
+    }
+    else
+    {
+        filters.reset();
+        std::fill(std::begin(feedbackTap), std::end(feedbackTap), SampleType(0));
+    }
+
+    return clearStep >= numClearSteps;
+}
+
+template <typename SampleType, int NumLines>
+void FdnReverbEngine<SampleType, NumLines>::skipSmoothing()
+{
+    // Nothing is audible while asleep, so parameter ramps can jump to their targets
+    if (sizeSmoothed.isSmoothing())
+    {
+        sizeSmoothed.setCurrentAndTargetValue(sizeSmoothed.getTargetValue());
+        applySize(sizeSmoothed.getTargetValue());
+    }
+
+    gravitySmoothed.setCurrentAndTargetValue(gravitySmoothed.getTargetValue());
+    feedbackSmoothed.setCurrentAndTargetValue(feedbackSmoothed.getTargetValue());
+    updateLineGains();
+    snapSmoothers = false;
+}
+
+template <typename SampleType, int NumLines>
+void FdnReverbEngine<SampleType, NumLines>::reset()
+{
+    std::fill(lineStorage.begin(), lineStorage.end(), SampleType(0));
+    writeCounter = 0;
+
+    std::fill(preDelayBuffer.begin(), preDelayBuffer.end(), 0.0f);
+    preDelayWritePos = 0;
+
+    filters.reset();
+    std::fill(std::begin(feedbackTap), std::end(feedbackTap), SampleType(0));
+    lfos.reset();
+
+    // Everything is clear, so start asleep until the first non-silent block
+    sleeping = true;
+    clearStep = 0;
+    numClearSteps = 0;
+    silenceDetector.reset();
+    endStaleRegions();
+}
+
+template class FdnReverbEngine<float, 8>;
+template class FdnReverbEngine<float, 16>;
+template class FdnReverbEngine<double, 8>;
+template class FdnReverbEngine<double, 16>;
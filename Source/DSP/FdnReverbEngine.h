@@ -0,0 +1,174 @@
+#pragma once
+#include <JuceHeader.h>
+#include "LfoBank.h"
+#include "SilenceDetector.h"
+#include "StaleRegion.h"
+#include "ReverbFilters.h"
+#include "ReverbTiers.h"
+#include <vector>
+
+// Feedback delay network reverb: NumLines delay lines whose outputs are damped per line,
+// mixed by a normalised Hadamard matrix (fast Walsh-Hadamard transform) and fed back
+// with a per-line gain that sets the decay time. Templated on the sample type and the
+// line count (8 or 16); instantiated for float and double in FdnReverbEngine.cpp.
+//
+// Every line is one lane: the damping filters, the mixing butterflies and the feedback
+// gains all run across the lines at once, and only the delay reads and writes (lines of
+// different lengths) are per line. Each output channel taps one row of the mixed lines.
+//
+// Same controls and interface as ReverbEngine: Size scales the line lengths, Feedback
+// sets the decay time and Gravity stretches it, Lo/Hi EQ and Resonance use the same
+// filters, and Freeze holds the network lossless with the input muted. A line's decay
+// gain comes close to 1 on long tails, so the loop filters never boost: the resonance
+// peaks sit on the output taps instead (see ReverbFilters::ResonancePlacement).
+template <typename SampleType, int NumLines>
+class FdnReverbEngine
+{
+public:
+    FdnReverbEngine() = default;
+
+    static constexpr int kMaxOutputChannels = ReverbTiers::kMaxOutputChannels;
+
+    void prepare(double sampleRate, int samplesPerBlock, int numOutputChannels);
+    void setGravity(float gravity);
+    void setSize(float size);
+    void setPreDelay(float ms);
+    void setFeedback(float percent);
+    void setModulation(float depthPercent, float rateHz);
+    void setLoEQ(float dB)              { filters.setLoEQ(dB); }
+    void setHiEQ(float dB)              { filters.setHiEQ(dB); }
+    void setResonance(float percent)    { filters.setResonance(percent); }
+    void setFreeze(bool frozen)         { isFrozen = frozen; }
+    void setKillDry(bool kill)          { killDrySignal = kill; }
+
+    // Coefficient handling as in ReverbEngine
+    void updateCoefficients()                                 { filters.updateCoefficients(); }
+    bool installCoefficients(const ReverbCoefficientSet& set) { return filters.installCoefficients(set); }
+    void interpolateCoefficients(const ReverbCoefficientSet& a, const ReverbCoefficientSet& b, float t)
+    {
+        filters.interpolateCoefficients(a, b, t);
+    }
+    void invalidateCoefficients()                             { filters.invalidateCoefficients(); }
+
+    void process(juce::AudioBuffer<SampleType>& buffer);
+    void reset();
+
+    // True while the engine is idle on silence (see process())
+    bool isSleeping() const noexcept { return sleeping; }
+    void setSleepEnabled(bool enabled) noexcept { sleepEnabled = enabled; }
+
+    // Last loop sample tapped for each output channel (0 = left), for metering loop energy
+    float getFeedbackSample(int channel) const noexcept
+    {
+        return static_cast<float>(feedbackTap[channel]);
+    }
+
+    // Estimated time for the tail to decay below the sleep threshold after the
+    // input stops, from the current targets. Infinite while frozen.
+    double getTailLengthSeconds() const;
+
+private:
+    static_assert(NumLines == 8 || NumLines == 16, "The Hadamard mix needs a power-of-two line count");
+    static_assert(NumLines % SimdLanes::width<SampleType> == 0, "Lines must fill whole SIMD registers");
+    static_assert(NumLines <= ReverbFilters<SampleType>::kMaxLanes, "Too many lines for the filters");
+
+    static constexpr int kControlBlockSize = 32;
+    static constexpr int kMaxPreDelaySamples = 96000;
+    static constexpr int kMaxLanes = ReverbFilters<SampleType>::kMaxLanes;
+    static_assert(kMaxLanes >= SimdLanes::paddedLanes<SampleType>(kMaxOutputChannels), "Too few output lanes");
+
+    // Control rate: Size, Gravity and Feedback move the line lengths and gains once per
+    // control block
+    void updateControlRate(int numSamples);
+    void applySize(float scaleFactor);
+    void updateLineGains();
+    float decaySeconds() const;
+
+    void render(SampleType* const* channels, int numOutputs, int numSamples);
+
+    // In-place normalised Hadamard transform of one sample per line (lanes aligned)
+    static void mixLines(SampleType* lanes) noexcept;
+
+    // In place: each mixed line times its decay gain (the freeze gain while frozen), plus
+    // its share of `input`
+    void feedLines(SampleType* lanes, SampleType input) noexcept;
+
+    // Output channel `channel` from the mixed lines
+    SampleType tapOutput(int channel, const SampleType* mixed) const noexcept;
+
+    // Sleep on silence, as in ReverbEngine: the lines are cleared one per sleeping block,
+    // and whatever is left at a wake-up is cleared ahead of the reads (StaleRegion)
+    void enterSleep();
+    void wakeUp();
+    bool clearNextSlice();
+    void clearStaleAhead(int numSamples);
+    void endStaleRegions();
+    void skipSmoothing();
+    int longestPathSamples() const;
+
+    // Line lengths at 44.1kHz (in samples) — primes spread over the span of the allpass
+    // tables; the 8-line network takes every other one
+    static constexpr int lineDelays[16] = {
+        1031, 1151, 1277, 1399, 1523, 1657, 1789, 1931,
+        2069, 2213, 2357, 2503, 2657, 2819, 2971, 3137
+    };
+    static int baseDelay(int line) { return lineDelays[line * (16 / NumLines)]; }
+
+    // Delay lines back to back in one buffer, each a power of two long, sharing one
+    // write counter
+    std::vector<SampleType> lineStorage;
+    size_t lineOffset[NumLines] {};
+    juce::uint32 lineMask[NumLines] {};
+    float lineDelay[NumLines] {};              // Current length (Size applied)
+    float maxLineDelay[NumLines] {};
+    juce::uint32 writeCounter = 0;
+
+    // Per-line feedback gain for the decay time, and the signed input share
+    alignas(SimdLanes::kAlignment) SampleType lineGain[NumLines] {};
+    alignas(SimdLanes::kAlignment) SampleType inputGain[NumLines] {};
+    bool lineGainsDirty = true;
+
+    // Which mixed rows feed each output channel (second row only where the network has
+    // fewer distinct rows than outputs; -1 otherwise)
+    int outputRow[kMaxOutputChannels] {};
+    int outputPartner[kMaxOutputChannels] {};
+
+    LfoBank lfos;
+    float modOffsets[NumLines] {};
+
+    // Pre-delay
+    std::vector<SampleType> preDelayBuffer;
+    size_t preDelayMask = 0;
+    int preDelayWritePos = 0;
+    float preDelaySamples = 0.0f;
+
+    // Feedback filters one lane per line, output filters one lane per output channel
+    ReverbFilters<SampleType> filters { ReverbFilters<SampleType>::ResonancePlacement::onOutput };
+    alignas(SimdLanes::kAlignment) SampleType feedbackTap[kMaxLanes] {};
+
+    juce::SmoothedValue<float> sizeSmoothed { 1.0f };
+    juce::SmoothedValue<float> gravitySmoothed;
+    juce::SmoothedValue<float> feedbackSmoothed;
+    bool snapSmoothers = true;     // Setters jump to target until the first process() after prepare()
+
+    double currentSampleRate = 44100.0;
+    float sampleRateScale = 1.0f;
+    float currentSize = 1.0f;
+    float currentGravity = 0.0f;
+    float feedbackAmount = 0.0f;
+    float modDepthSamples = 0.0f;
+    bool isFrozen = false;
+    bool killDrySignal = false;
+    int numChains = 2;             // Output channels prepared
+
+    SilenceDetector silenceDetector;
+    bool sleeping = false;
+    bool sleepEnabled = true;
+    int clearStep = 0;
+    int numClearSteps = 0;
+
+    // Lines and pre-delay still holding samples from before the last wake-up
+    StaleRegion staleLines[NumLines];
+    StaleRegion stalePreDelay;
+    bool clearingStale = false;
+};
@@ -1,7 +1,15 @@
 #include "FilterUtils.h"
 
 // HighPassFilter
-void HighPassFilter::prepare(double sampleRate, int samplesPerBlock)
+template <typename SampleType>
+HighPassFilter<SampleType>::HighPassFilter()
+{
+    // Second-order storage, overwritten by setCutoff()
+    filter.coefficients = new juce::dsp::IIR::Coefficients<SampleType>(1, 0, 0, 1, 0, 0);
+}
+
+template <typename SampleType>
+void HighPassFilter<SampleType>::prepare(double sampleRate, int samplesPerBlock)
 {
     currentSampleRate = sampleRate;
     juce::dsp::ProcessSpec spec{sampleRate, static_cast<juce::uint32>(samplesPerBlock), 1};
@@ -9,26 +17,46 @@ void HighPassFilter::prepare(double sampleRate, int samplesPerBlock)
     reset();
 }
 
-void HighPassFilter::setCutoff(float freqHz)
+template <typename SampleType>
+void HighPassFilter<SampleType>::setCutoff(float freqHz)
 {
-    filter.coefficients = juce::dsp::IIR::Coefficients<float>::makeHighPass(
-        currentSampleRate,
-        juce::jlimit(20.0f, static_cast<float>(currentSampleRate * 0.49), freqHz)
-    );
+    // Butterworth high-pass, same design as Coefficients::makeHighPass (Q = 1/sqrt 2)
+    const double f = juce::jlimit(20.0, currentSampleRate * 0.49, static_cast<double>(freqHz));
+    const double n = std::tan(juce::MathConstants<double>::pi * f / currentSampleRate);
+    const double nSquared = n * n;
+    const double invQ = juce::MathConstants<double>::sqrt2;
+    const double c1 = 1.0 / (1.0 + invQ * n + nSquared);
+
+    auto* c = filter.coefficients->getRawCoefficients();
+    c[0] = static_cast<SampleType>(c1);
+    c[1] = static_cast<SampleType>(c1 * -2.0);
+    c[2] = static_cast<SampleType>(c1);
+    c[3] = static_cast<SampleType>(c1 * 2.0 * (nSquared - 1.0));
+    c[4] = static_cast<SampleType>(c1 * (1.0 - invQ * n + nSquared));
 }
 
-float HighPassFilter::processSample(float input)
+template <typename SampleType>
+SampleType HighPassFilter<SampleType>::processSample(SampleType input)
 {
     return filter.processSample(input);
 }
 
-void HighPassFilter::reset()
+template <typename SampleType>
+void HighPassFilter<SampleType>::reset()
 {
     filter.reset();
 }
 
 // LowPassFilter
-void LowPassFilter::prepare(double sampleRate, int samplesPerBlock)
+template <typename SampleType>
+LowPassFilter<SampleType>::LowPassFilter()
+{
+    // First-order storage, overwritten by setCutoff()
+    filter.coefficients = new juce::dsp::IIR::Coefficients<SampleType>(1, 0, 1, 0);
+}
+
+template <typename SampleType>
+void LowPassFilter<SampleType>::prepare(double sampleRate, int samplesPerBlock)
 {
     currentSampleRate = sampleRate;
     juce::dsp::ProcessSpec spec{sampleRate, static_cast<juce::uint32>(samplesPerBlock), 1};
@@ -36,136 +64,95 @@ void LowPassFilter::prepare(double sampleRate, int samplesPerBlock)
     reset();
 }
 
-void LowPassFilter::setCutoff(float freqHz)
+template <typename SampleType>
+void LowPassFilter<SampleType>::setCutoff(float freqHz)
 {
-    filter.coefficients = juce::dsp::IIR::Coefficients<float>::makeFirstOrderLowPass(
-        currentSampleRate,
-        juce::jlimit(20.0f, static_cast<float>(currentSampleRate * 0.49), freqHz)
-    );
+    // One-pole low-pass, same design as Coefficients::makeFirstOrderLowPass
+    const double f = juce::jlimit(20.0, currentSampleRate * 0.49, static_cast<double>(freqHz));
+    const double n = std::tan(juce::MathConstants<double>::pi * f / currentSampleRate);
+
+    auto* c = filter.coefficients->getRawCoefficients();
+    c[0] = static_cast<SampleType>(n / (n + 1.0));
+    c[1] = static_cast<SampleType>(n / (n + 1.0));
+    c[2] = static_cast<SampleType>((n - 1.0) / (n + 1.0));
 }
 
-float LowPassFilter::processSample(float input)
+template <typename SampleType>
+SampleType LowPassFilter<SampleType>::processSample(SampleType input)
 {
     return filter.processSample(input);
 }
 
-void LowPassFilter::reset()
+template <typename SampleType>
+void LowPassFilter<SampleType>::reset()
 {
     filter.reset();
 }
 
-// AllPassDelay
-AllPassDelay::AllPassDelay(int maxDelaySamples)
+// LaneBiquadChain
+namespace
 {
-    init(maxDelaySamples);
-}
+    // Relative tolerance for a numerator matching its denominator: designers asked for
+    // 0 dB produce b == a up to rounding
+    constexpr double kUnityTolerance = 1.0e-12;
 
-void AllPassDelay::init(int maxDelaySamples)
-{
-    bufferSize = juce::nextPowerOfTwo(maxDelaySamples);
-    bufferMask = bufferSize - 1;
-    buffer.resize(bufferSize, 0.0f);
+    bool isUnity(const std::array<double, 5>& c)
+    {
+        auto near = [](double x, double y) { return std::abs(x - y) <= kUnityTolerance * (1.0 + std::abs(y)); };
+        return near(c[0], 1.0) && near(c[1], c[3]) && near(c[2], c[4]);
+    }
 }
 
-void AllPassDelay::prepare(double sr)
+template <typename SampleType>
+void LaneBiquadChain<SampleType>::setSection(int index, const std::array<double, 5>& c)
 {
-    sampleRate = sr;
-    reset();
-}
+    jassert(index >= 0 && index < kMaxSections);
+    auto& section = sections[static_cast<size_t>(index)];
 
-void AllPassDelay::setDelay(float samples)
-{
-    delaySamples = juce::jlimit(1.0f, static_cast<float>(bufferSize - 4), samples);
-}
+    section.b0 = static_cast<SampleType>(c[0]);
+    section.b1 = static_cast<SampleType>(c[1]);
+    section.b2 = static_cast<SampleType>(c[2]);
+    section.a1 = static_cast<SampleType>(c[3]);
+    section.a2 = static_cast<SampleType>(c[4]);
+    section.section = index;
+    section.unity = isUnity(c);
 
-void AllPassDelay::setCoefficient(float g)
-{
-    coefficient = juce::jlimit(-0.99f, 0.99f, g);
+    numSections = std::max(numSections, index + 1);
 }
 
-void AllPassDelay::setDecayGain(float gain)
+template <typename SampleType>
+void LaneBiquadChain<SampleType>::compile() noexcept
 {
-    decayGain = juce::jlimit(0.99f, 1.0f, gain);
-}
-
-float AllPassDelay::processSample(float input)
-{
-    // Split delay into integer and fractional parts
-    int delayInt = static_cast<int>(delaySamples);
-    float frac = delaySamples - static_cast<float>(delayInt);
-
-    // Calculate read positions with proper wrapping
-    int readPos0 = (writePos - delayInt + static_cast<int>(bufferSize)) & bufferMask;
-    int readPos1 = (writePos - delayInt - 1 + static_cast<int>(bufferSize)) & bufferMask;
+    numActive = 0;
 
-    // Linear interpolation with safe indices — reads v[n-D]
-    float delayed = buffer[readPos0] + frac * (buffer[readPos1] - buffer[readPos0]);
+    for (int i = 0; i < numSections; ++i)
+    {
+        const auto& section = sections[static_cast<size_t>(i)];
+        if (section.unity)
+        {
+            // Left out: its state has to read zero when it comes back
+            std::fill(std::begin(state1[i]), std::end(state1[i]), SampleType(0));
+            std::fill(std::begin(state2[i]), std::end(state2[i]), SampleType(0));
+            continue;
+        }
 
-    // Apply per-allpass decay gain (gentle energy loss per stage)
-    delayed *= decayGain;
-
-    // Schroeder allpass:
-    //   v[n]   = input + g * v[n-D]     (state variable stored in buffer)
-    //   y[n]   = v[n-D] - g * v[n]      (energy-preserving, truly unity gain)
-    float v = input + coefficient * delayed;
-    float output = delayed - coefficient * v;
-
-    // Write state variable v (NOT input) to buffer — this is critical for correct allpass behavior
-    buffer[writePos & bufferMask] = v;
-    writePos = (writePos + 1) & bufferMask;
-
-    return output;
-}
-
-void AllPassDelay::setModulation(float depthSamples, float rateHz, float phaseOffset)
-{
-    baseDelay = delaySamples;
-    modDepth = depthSamples;
-    lfoPhaseOffset = phaseOffset;
-    lfoIncrement = (rateHz * juce::MathConstants<float>::twoPi) / static_cast<float>(sampleRate);
-}
-
-void AllPassDelay::setModOffset(float offsetSamples)
-{
-    modOffset = offsetSamples;
+        program[static_cast<size_t>(numActive++)] = section;
+    }
 }
 
-float AllPassDelay::processSampleModulated(float input)
+template <typename SampleType>
+void LaneBiquadChain<SampleType>::reset()
 {
-    // Clamp total delay to valid range
-    float totalDelay = juce::jlimit(1.0f, static_cast<float>(bufferSize - 2), delaySamples + modOffset);
-
-    // Split into integer and fractional parts
-    int delayInt = static_cast<int>(totalDelay);
-    float frac = totalDelay - static_cast<float>(delayInt);
-
-    // Calculate read positions — add bufferSize before masking to handle negative values
-    int readPos0 = (writePos - delayInt + static_cast<int>(bufferSize)) & bufferMask;
-    int readPos1 = (writePos - delayInt - 1 + static_cast<int>(bufferSize)) & bufferMask;
-
-    // Linear interpolation — reads v[n-D]
-    float delayed = buffer[readPos0] + frac * (buffer[readPos1] - buffer[readPos0]);
-
-    // Apply per-allpass decay gain (gentle energy loss per stage)
-    delayed *= decayGain;
-
-    // Schroeder allpass (identical formula to processSample):
-    //   v[n]   = input + g * v[n-D]     (state variable stored in buffer)
-    //   y[n]   = v[n-D] - g * v[n]      (energy-preserving, truly unity gain)
-    float v = input + coefficient * delayed;
-    float output = delayed - coefficient * v;
-
-    // Write state variable v (NOT input) to buffer
-    buffer[writePos & bufferMask] = v;
-    writePos = (writePos + 1) & bufferMask;
-
-    return output;
+    for (int i = 0; i < kMaxSections; ++i)
+    {
+        std::fill(std::begin(state1[i]), std::end(state1[i]), SampleType(0));
+        std::fill(std::begin(state2[i]), std::end(state2[i]), SampleType(0));
+    }
 }
 
-void AllPassDelay::reset()
-{
-    std::fill(buffer.begin(), buffer.end(), 0.0f);
-    writePos = 0;
-    delayedOutput = 0.0f;
-    lfoPhase = 0.0f;
-}
+template class HighPassFilter<float>;
+template class HighPassFilter<double>;
+template class LowPassFilter<float>;
+template class LowPassFilter<double>;
+template class LaneBiquadChain<float>;
+template class LaneBiquadChain<double>;
@@ -1,72 +1,110 @@
 #pragma once
 #include <JuceHeader.h>
+#include "SimdLanes.h"
+#include <array>
 
+// All filters are templated on the audio sample type (float or double); they are
+// explicitly instantiated for both in FilterUtils.cpp.
+//
+// The high- and low-pass filters own their coefficient storage and setCutoff()
+// recomputes it in place, so cutoff changes never allocate on the audio thread.
+template <typename SampleType>
 class HighPassFilter
 {
 public:
-    HighPassFilter() = default;
+    HighPassFilter();
 
     void prepare(double sampleRate, int samplesPerBlock);
     void setCutoff(float freqHz);
-    float processSample(float input);
+    SampleType processSample(SampleType input);
     void reset();
 
 private:
-    juce::dsp::IIR::Filter<float> filter;
+    juce::dsp::IIR::Filter<SampleType> filter;
     double currentSampleRate = 44100.0;
 };
 
+template <typename SampleType>
 class LowPassFilter
 {
 public:
-    LowPassFilter() = default;
+    LowPassFilter();
 
     void prepare(double sampleRate, int samplesPerBlock);
     void setCutoff(float freqHz);
-    float processSample(float input);
+    SampleType processSample(SampleType input);
     void reset();
 
 private:
-    juce::dsp::IIR::Filter<float> filter;
+    juce::dsp::IIR::Filter<SampleType> filter;
     double currentSampleRate = 44100.0;
 };
 
-class AllPassDelay
+// A cascade of biquad sections run on several channels at once, one channel per SIMD lane;
+// every lane shares the section coefficients. Each section is transposed direct form II
+// with the same arithmetic as juce::dsp::IIR::Filter.
+//
+// setSection() only stores coefficients; compile() then builds the program process() runs:
+// sections that are unity gain (numerator equal to denominator) are left out and the rest
+// are run in order with the signal kept in a register from the first section to the last.
+// A section keeps its own state wherever it sits in the program, and a unity section's
+// state stays at zero while it runs, so leaving it out changes nothing audible.
+template <typename SampleType>
+class LaneBiquadChain
 {
 public:
-    AllPassDelay() = default;
-    explicit AllPassDelay(int maxDelaySamples);
+    static constexpr int kMaxSections = 6;
+    static constexpr int kMaxLanes = 16;
 
-    void init(int maxDelaySamples);
-    void prepare(double sampleRate);
-    void setDelay(float delaySamples);
-    void setCoefficient(float g);
-    void setDecayGain(float gain);
-    float processSample(float input);
+    // Normalised b0, b1, b2, a1, a2 (a0 = 1); a first-order section has b2 = a2 = 0
+    void setSection(int index, const std::array<double, 5>& c);
 
-    void setModulation(float depthSamples, float rateHz, float phaseOffset);
-    void setModOffset(float offsetSamples);
-    float processSampleModulated(float input);
+    // Rebuilds the program from the current sections (call after a batch of setSection())
+    void compile() noexcept;
+    int getNumActiveSections() const noexcept { return numActive; }
+
+    // Filters `numLanes` samples in place — one per lane. numLanes must be a multiple of
+    // the SIMD width and `lanes` aligned to SimdLanes::kAlignment.
+    void process(SampleType* lanes, int numLanes) noexcept
+    {
+        using namespace SimdLanes;
+
+        for (int i = 0; i < numLanes; i += width<SampleType>)
+        {
+            auto x = load(lanes + i);
+
+            for (int k = 0; k < numActive; ++k)
+            {
+                const auto& op = program[k];
+                SampleType* s1 = state1[op.section] + i;
+                SampleType* s2 = state2[op.section] + i;
+
+                const auto y = broadcast(op.b0) * x + load(s1);
+                store(s1, broadcast(op.b1) * x - broadcast(op.a1) * y + load(s2));
+                store(s2, broadcast(op.b2) * x - broadcast(op.a2) * y);
+                x = y;
+            }
+
+            store(lanes + i, x);
+        }
+    }
 
     void reset();
 
 private:
-    std::vector<float> buffer;
-    size_t bufferSize = 0;
-    size_t bufferMask = 0;
-    int writePos = 0;
-
-    float delaySamples = 0.0f;
-    float coefficient = 0.7f;
-    float decayGain = 1.0f;
-    float delayedOutput = 0.0f;
-
-    // Modulation
-    double sampleRate = 44100.0;
-    float baseDelay = 0.0f;
-    float modDepth = 0.0f;
-    float modOffset = 0.0f;
-    float lfoPhase = 0.0f;
-    float lfoPhaseOffset = 0.0f;
-    float lfoIncrement = 0.0f;
+    struct Section
+    {
+        SampleType b0 = SampleType(1), b1 = SampleType(0), b2 = SampleType(0);
+        SampleType a1 = SampleType(0), a2 = SampleType(0);
+        int section = 0;           // Index of the section's state
+        bool unity = true;
+    };
+
+    std::array<Section, kMaxSections> sections {};
+    std::array<Section, kMaxSections> program {};
+    int numSections = 0;           // One past the highest section set
+    int numActive = 0;
+
+    alignas(SimdLanes::kAlignment) SampleType state1[kMaxSections][kMaxLanes] {};
+    alignas(SimdLanes::kAlignment) SampleType state2[kMaxSections][kMaxLanes] {};
 };
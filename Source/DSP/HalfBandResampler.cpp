@@ -0,0 +1,270 @@
+#include "HalfBandResampler.h"
+#include <array>
+
+namespace
+{
+    constexpr int kTaps = HalfBandResampler<float>::kTapsPerBranch;
+
+    // Kaiser window shape: about 80 dB of stopband for the 47-tap filter
+    constexpr double kKaiserBeta = 8.0;
+
+    double besselI0(double x)
+    {
+        double sum = 1.0, term = 1.0;
+        for (int k = 1; k < 32; ++k)
+        {
+            term *= (x / (2.0 * k)) * (x / (2.0 * k));
+            sum += term;
+        }
+        return sum;
+    }
+
+    // Windowed-sinc half-band taps at odd offsets 1, 3, 5, ... from the centre, scaled so
+    // the filter has unity gain at DC (centre 0.5 plus twice the sum of the taps)
+    std::array<double, kTaps> designHalfBand()
+    {
+        std::array<double, kTaps> taps {};
+        const double halfLength = 2.0 * kTaps;
+        double sum = 0.0;
+
+        for (int j = 0; j < kTaps; ++j)
+        {
+            const double offset = 2.0 * j + 1.0;
+            const double ratio = offset / halfLength;
+            const double window = besselI0(kKaiserBeta * std::sqrt(1.0 - ratio * ratio)) / besselI0(kKaiserBeta);
+            const double sinc = ((j & 1) != 0 ? -1.0 : 1.0) / (juce::MathConstants<double>::pi * offset);
+            taps[(size_t) j] = sinc * window;
+            sum += taps[(size_t) j];
+        }
+
+        for (auto& tap : taps)
+            tap *= 0.25 / sum;
+
+        return taps;
+    }
+}
+
+template <typename SampleType>
+const SampleType* HalfBandResampler<SampleType>::coefficients()
+{
+    static const auto taps = []
+    {
+        const auto design = designHalfBand();
+        std::array<SampleType, kTapsPerBranch> converted {};
+        for (size_t j = 0; j < converted.size(); ++j)
+            converted[j] = static_cast<SampleType>(design[j]);
+        return converted;
+    }();
+
+    return taps.data();
+}
+
+template <typename SampleType>
+void HalfBandResampler<SampleType>::prepare(int factor, int numChannels, int maxBlockSize)
+{
+    jassert(factor == 1 || factor == 2 || factor == 4);
+    numStages = factor >= 4 ? 2 : (factor >= 2 ? 1 : 0);
+
+    int stageBlockSize = maxBlockSize;
+    for (int s = 0; s < numStages; ++s)
+    {
+        stageBlockSize = lowRateBlockSize(2, stageBlockSize);
+        stages[s].prepare(numChannels, stageBlockSize);
+    }
+
+    coefficients();   // Designs the taps here rather than on the first audio block
+}
+
+template <typename SampleType>
+int HalfBandResampler<SampleType>::lowRateBlockSize(int factor, int maxBlockSize) noexcept
+{
+    // Each stage outputs one sample per even input, so at most half the block rounded up
+    for (; factor > 1; factor /= 2)
+        maxBlockSize = (maxBlockSize + 1) / 2;
+
+    return maxBlockSize;
+}
+
+template <typename SampleType>
+int HalfBandResampler<SampleType>::getLatencySamples() const noexcept
+{
+    // Both filters of a stage delay by their centre tap (4 * kTapsPerBranch - 1 taps long),
+    // counted at the stage's input rate
+    int latency = 0;
+    for (int s = 0; s < numStages; ++s)
+        latency += (2 * (2 * kTapsPerBranch - 1)) << s;
+
+    return latency;
+}
+
+template <typename SampleType>
+juce::AudioBuffer<SampleType> HalfBandResampler<SampleType>::decimate(juce::AudioBuffer<SampleType>& buffer)
+{
+    const int numChannels = buffer.getNumChannels();
+    const SampleType* const* input = buffer.getArrayOfReadPointers();
+    int numSamples = buffer.getNumSamples();
+
+    for (int s = 0; s < numStages; ++s)
+    {
+        numSamples = stages[s].decimate(input, numChannels, numSamples);
+        input = stages[s].output.getArrayOfReadPointers();
+    }
+
+    // Non-owning view onto the last stage's preallocated output
+    return juce::AudioBuffer<SampleType>(stages[numStages - 1].output.getArrayOfWritePointers(),
+                                         numChannels, numSamples);
+}
+
+template <typename SampleType>
+void HalfBandResampler<SampleType>::interpolate(juce::AudioBuffer<SampleType>& buffer)
+{
+    const int numChannels = buffer.getNumChannels();
+
+    for (int s = numStages - 1; s >= 0; --s)
+    {
+        auto& stage = stages[s];
+        if (s > 0)
+            stage.interpolate(stage.output.getArrayOfReadPointers(), stages[s - 1].output.getArrayOfWritePointers(),
+                              numChannels, stages[s - 1].lastOutputSamples);
+        else
+            stage.interpolate(stage.output.getArrayOfReadPointers(), buffer.getArrayOfWritePointers(),
+                              numChannels, buffer.getNumSamples());
+    }
+}
+
+template <typename SampleType>
+void HalfBandResampler<SampleType>::reset()
+{
+    for (auto& stage : stages)
+        stage.reset();
+}
+
+template <typename SampleType>
+void HalfBandResampler<SampleType>::Stage::prepare(int numChannels, int maxOutputSamples)
+{
+    const auto channels = static_cast<size_t>(numChannels);
+    evenHistory.assign(channels * 4 * kTapsPerBranch, SampleType(0));
+    oddHistory.assign(channels * 2 * kTapsPerBranch, SampleType(0));
+    upHistory.assign(channels * 4 * kTapsPerBranch, SampleType(0));
+    pendingOdd.assign(channels, SampleType(0));
+    output.setSize(numChannels, maxOutputSamples);
+    reset();
+}
+
+template <typename SampleType>
+void HalfBandResampler<SampleType>::Stage::reset()
+{
+    std::fill(evenHistory.begin(), evenHistory.end(), SampleType(0));
+    std::fill(oddHistory.begin(), oddHistory.end(), SampleType(0));
+    std::fill(upHistory.begin(), upHistory.end(), SampleType(0));
+    std::fill(pendingOdd.begin(), pendingOdd.end(), SampleType(0));
+    evenPos = oddPos = upPos = 0;
+    phase = blockStartPhase = 0;
+    lastOutputSamples = 0;
+}
+
+template <typename SampleType>
+int HalfBandResampler<SampleType>::Stage::decimate(const SampleType* const* input, int numChannels, int numSamples)
+{
+    constexpr int evenLength = 2 * kTapsPerBranch;
+    constexpr int oddLength = kTapsPerBranch;
+    const SampleType* taps = coefficients();
+
+    blockStartPhase = phase;
+    int numOutputs = 0;
+    int endEvenPos = evenPos, endOddPos = oddPos;
+
+    for (int ch = 0; ch < numChannels; ++ch)
+    {
+        const SampleType* in = input[ch];
+        SampleType* out = output.getWritePointer(ch);
+        SampleType* even = evenHistory.data() + static_cast<size_t>(ch) * 2 * evenLength;
+        SampleType* odd = oddHistory.data() + static_cast<size_t>(ch) * 2 * oddLength;
+        int e = evenPos, o = oddPos, p = phase, k = 0;
+
+        for (int n = 0; n < numSamples; ++n)
+        {
+            if (p == 0)
+            {
+                even[e] = even[e + evenLength] = in[n];
+                e = (e + 1) % evenLength;
+
+                // Oldest to newest from here on; the centre tap sits between w[K-1] and w[K]
+                const SampleType* w = even + e;
+                SampleType acc = SampleType(0.5) * odd[o];
+                for (int j = 0; j < kTapsPerBranch; ++j)
+                    acc += taps[j] * (w[kTapsPerBranch + j] + w[kTapsPerBranch - 1 - j]);
+
+                out[k++] = acc;
+            }
+            else
+            {
+                odd[o] = odd[o + oddLength] = in[n];
+                o = (o + 1) % oddLength;
+            }
+
+            p ^= 1;
+        }
+
+        numOutputs = k;
+        endEvenPos = e;
+        endOddPos = o;
+    }
+
+    evenPos = endEvenPos;
+    oddPos = endOddPos;
+    phase = (phase + numSamples) & 1;
+    lastOutputSamples = numOutputs;
+    return numOutputs;
+}
+
+template <typename SampleType>
+void HalfBandResampler<SampleType>::Stage::interpolate(const SampleType* const* input, SampleType* const* dest,
+                                                       int numChannels, int numSamples)
+{
+    constexpr int length = 2 * kTapsPerBranch;
+    const SampleType* taps = coefficients();
+    int endPos = upPos;
+
+    for (int ch = 0; ch < numChannels; ++ch)
+    {
+        const SampleType* in = input[ch];
+        SampleType* out = dest[ch];
+        SampleType* history = upHistory.data() + static_cast<size_t>(ch) * 2 * length;
+        SampleType& pending = pendingOdd[static_cast<size_t>(ch)];
+        int u = upPos, p = blockStartPhase, k = 0;
+
+        for (int n = 0; n < numSamples; ++n)
+        {
+            if (p == 0)
+            {
+                history[u] = history[u + length] = in[k++];
+                u = (u + 1) % length;
+
+                // Zero-stuffed input through the filter at twice its gain: the even output
+                // takes the off-centre taps, the odd output only the centre one
+                const SampleType* w = history + u;
+                SampleType acc = SampleType(0);
+                for (int j = 0; j < kTapsPerBranch; ++j)
+                    acc += taps[j] * (w[kTapsPerBranch + j] + w[kTapsPerBranch - 1 - j]);
+
+                out[n] = SampleType(2) * acc;
+                pending = w[kTapsPerBranch];
+            }
+            else
+            {
+                out[n] = pending;
+            }
+
+            p ^= 1;
+        }
+
+        jassert(k == lastOutputSamples);
+        endPos = u;
+    }
+
+    upPos = endPos;
+}
+
+template class HalfBandResampler<float>;
+template class HalfBandResampler<double>;
@@ -0,0 +1,93 @@
+#pragma once
+#include <JuceHeader.h>
+#include <vector>
+
+// Runs a block process at 1/2 or 1/4 of the host rate: the block is decimated through a
+// cascade of polyphase half-band FIR stages, handed to the processing function, and
+// interpolated back through the same stages. Templated on the sample type; instantiated
+// for float and double in HalfBandResampler.cpp.
+//
+// Each stage is a linear-phase half-band filter of 4 * kTapsPerBranch - 1 taps. Every
+// other tap is zero apart from the centre one, so a stage splits into two branches:
+//   - decimating, each output is kTapsPerBranch symmetric pairs from the even input
+//     samples plus the centre tap on the odd ones;
+//   - interpolating, each input gives an even output from kTapsPerBranch pairs and an odd
+//     output that is the input delayed.
+// Blocks of any length work: a stage keeps its even/odd phase across blocks and holds
+// the second output of an interpolated pair over when a block ends between the two.
+template <typename SampleType>
+class HalfBandResampler
+{
+public:
+    HalfBandResampler() = default;
+
+    static constexpr int kMaxStages = 2;
+    static constexpr int kTapsPerBranch = 12;
+
+    // factor is 1 (pass-through), 2 or 4. Allocates.
+    void prepare(int factor, int numChannels, int maxBlockSize);
+
+    int getFactor() const noexcept { return 1 << numStages; }
+
+    // Longest block the processing function is handed for host blocks of maxBlockSize
+    static int lowRateBlockSize(int factor, int maxBlockSize) noexcept;
+
+    // Delay of the decimate + interpolate round trip, in host-rate samples
+    int getLatencySamples() const noexcept;
+
+    // Decimates `buffer`, runs processLowRate on the low-rate block (an AudioBuffer<SampleType>&
+    // it may process in place) and writes the interpolated result back into `buffer`
+    template <typename Function>
+    void process(juce::AudioBuffer<SampleType>& buffer, Function&& processLowRate)
+    {
+        if (numStages == 0)
+        {
+            processLowRate(buffer);
+            return;
+        }
+
+        auto lowRate = decimate(buffer);
+        processLowRate(lowRate);
+        interpolate(buffer);
+    }
+
+    void reset();
+
+private:
+    struct Stage
+    {
+        void prepare(int numChannels, int maxOutputSamples);
+        void reset();
+
+        // Returns the number of outputs written
+        int decimate(const SampleType* const* input, int numChannels, int numSamples);
+        void interpolate(const SampleType* const* input, SampleType* const* output,
+                         int numChannels, int numSamples);
+
+        // History lines are stored twice over so the newest `length` samples are always
+        // contiguous (write at i and i + length)
+        std::vector<SampleType> evenHistory;     // 2 * kTapsPerBranch per channel
+        std::vector<SampleType> oddHistory;      // kTapsPerBranch per channel
+        std::vector<SampleType> upHistory;       // 2 * kTapsPerBranch per channel
+        std::vector<SampleType> pendingOdd;      // Per channel
+        int evenPos = 0;
+        int oddPos = 0;
+        int upPos = 0;
+
+        int phase = 0;                           // 0: next host sample is even
+        int blockStartPhase = 0;                 // Phase before the last decimate()
+        int lastOutputSamples = 0;
+
+        juce::AudioBuffer<SampleType> output;    // Decimated block
+    };
+
+    // Returns a view of the lowest-rate block
+    juce::AudioBuffer<SampleType> decimate(juce::AudioBuffer<SampleType>& buffer);
+    void interpolate(juce::AudioBuffer<SampleType>& buffer);
+
+    // Non-zero off-centre taps at offsets 1, 3, 5, ... from the centre (the centre is 0.5)
+    static const SampleType* coefficients();
+
+    Stage stages[kMaxStages];
+    int numStages = 0;
+};
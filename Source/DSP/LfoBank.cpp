@@ -0,0 +1,55 @@
+#include "LfoBank.h"
+
+void LfoBank::init(const float* phases, int numLfos)
+{
+    startPhases.assign(phases, phases + numLfos);
+
+    const auto n = static_cast<size_t>(numLfos);
+    sinState.resize(n);
+    cosState.resize(n);
+    value.resize(n);
+    step.resize(n);
+
+    reset();
+}
+
+void LfoBank::advance(int numSamples, int count) noexcept
+{
+    jassert(count <= static_cast<int>(value.size()));
+
+    const float angle = increment * static_cast<float>(numSamples);
+    const float cosAngle = std::cos(angle);
+    const float sinAngle = std::sin(angle);
+    const float perSample = 1.0f / static_cast<float>(numSamples);
+    const auto n = static_cast<size_t>(count);
+
+    for (size_t i = 0; i < n; ++i)
+    {
+        const float s = sinState[i];
+        const float c = cosState[i];
+        float nextSin = s * cosAngle + c * sinAngle;
+        float nextCos = c * cosAngle - s * sinAngle;
+
+        // First-order renormalisation keeps the rotator on the unit circle; rounding
+        // would otherwise let the amplitude drift over long sessions
+        const float gain = 1.5f - 0.5f * (nextSin * nextSin + nextCos * nextCos);
+        nextSin *= gain;
+        nextCos *= gain;
+
+        value[i] = s;
+        step[i] = (nextSin - s) * perSample;
+        sinState[i] = nextSin;
+        cosState[i] = nextCos;
+    }
+}
+
+void LfoBank::reset() noexcept
+{
+    for (size_t i = 0; i < startPhases.size(); ++i)
+    {
+        sinState[i] = std::sin(startPhases[i]);
+        cosState[i] = std::cos(startPhases[i]);
+        value[i] = sinState[i];
+        step[i] = 0.0f;
+    }
+}
@@ -0,0 +1,218 @@
+#include "MixStage.h"
+#include "Smoothing.h"
+
+namespace
+{
+    constexpr double kGainRampSeconds = 0.02;
+
+    // FloatVectorOperations-style kernels. Gains are linear ramps g(i) = start + step * (i + 1),
+    // which keeps every loop a straight multiply-add the compiler can vectorize.
+
+    // io = io * g, dry = io, send = io (send may be null)
+    template <typename SampleType>
+    void gainAndFanOut(SampleType* io, SampleType* dry, SampleType* send, int numSamples,
+                       SampleType start, SampleType step)
+    {
+        if (send != nullptr)
+        {
+            for (int i = 0; i < numSamples; ++i)
+            {
+                const SampleType v = io[i] * (start + step * static_cast<SampleType>(i + 1));
+                io[i] = v;
+                dry[i] = v;
+                send[i] = v;
+            }
+        }
+        else
+        {
+            for (int i = 0; i < numSamples; ++i)
+            {
+                const SampleType v = io[i] * (start + step * static_cast<SampleType>(i + 1));
+                io[i] = v;
+                dry[i] = v;
+            }
+        }
+    }
+
+    // io = io * w(i) + dry * d(i)
+    template <typename SampleType>
+    void crossfade(SampleType* io, const SampleType* dry, int numSamples,
+                   SampleType dStart, SampleType dStep, SampleType wStart, SampleType wStep)
+    {
+        for (int i = 0; i < numSamples; ++i)
+        {
+            const SampleType t = static_cast<SampleType>(i + 1);
+            io[i] = io[i] * (wStart + wStep * t) + dry[i] * (dStart + dStep * t);
+        }
+    }
+
+    // io = (io + (rev - io) * b(i)) * w(i) + dry * d(i)
+    template <typename SampleType>
+    void blendAndCrossfade(SampleType* io, const SampleType* rev, const SampleType* dry, int numSamples,
+                           SampleType bStart, SampleType bStep, SampleType dStart, SampleType dStep,
+                           SampleType wStart, SampleType wStep)
+    {
+        for (int i = 0; i < numSamples; ++i)
+        {
+            const SampleType t = static_cast<SampleType>(i + 1);
+            const SampleType wet = io[i] + (rev[i] - io[i]) * (bStart + bStep * t);
+            io[i] = wet * (wStart + wStep * t) + dry[i] * (dStart + dStep * t);
+        }
+    }
+}
+
+void MixStage::prepare(double sampleRate)
+{
+    inputGain.reset(sampleRate, kGainRampSeconds);
+    outputGain.reset(sampleRate, kGainRampSeconds);
+    dryGain.reset(sampleRate, kGainRampSeconds);
+    wetGain.reset(sampleRate, kGainRampSeconds);
+    balance.reset(sampleRate, kGainRampSeconds);
+    snapSmoothers = true;
+}
+
+void MixStage::setInputGain(float gain)
+{
+    setSmoothedTarget(inputGain, gain, snapSmoothers);
+}
+
+void MixStage::setOutputGain(float gain)
+{
+    setSmoothedTarget(outputGain, gain, snapSmoothers);
+}
+
+void MixStage::setMix(float mix)
+{
+    mixAmount = juce::jlimit(0.0f, 1.0f, mix);
+    updateCrossfadeTargets();
+}
+
+void MixStage::setBalance(float newBalance)
+{
+    setSmoothedTarget(balance, juce::jlimit(0.0f, 1.0f, newBalance), snapSmoothers);
+}
+
+void MixStage::setKillDry(bool kill)
+{
+    killDrySignal = kill;
+    updateCrossfadeTargets();
+}
+
+void MixStage::setCrossfadeLaw(CrossfadeLaw law)
+{
+    crossfadeLaw = law;
+    updateCrossfadeTargets();
+}
+
+void MixStage::updateCrossfadeTargets()
+{
+    float dry, wet;
+
+    if (killDrySignal)
+    {
+        // 100% wet when kill dry is on (ramped, so toggling doesn't click)
+        dry = 0.0f;
+        wet = 1.0f;
+    }
+    else if (crossfadeLaw == CrossfadeLaw::EqualPower)
+    {
+        // Constant power: dry² + wet² = 1, so uncorrelated dry/wet keep their loudness mid-sweep
+        const float angle = mixAmount * juce::MathConstants<float>::halfPi;
+        dry = std::cos(angle);
+        wet = std::sin(angle);
+    }
+    else
+    {
+        dry = 1.0f - mixAmount;
+        wet = mixAmount;
+    }
+
+    setSmoothedTarget(dryGain, dry, snapSmoothers);
+    setSmoothedTarget(wetGain, wet, snapSmoothers);
+}
+
+MixStage::Ramp MixStage::advance(juce::SmoothedValue<float>& value, int numSamples)
+{
+    Ramp ramp;
+    ramp.start = value.getCurrentValue();
+
+    if (value.isSmoothing())
+    {
+        const float end = value.skip(numSamples);
+        ramp.step = (end - ramp.start) / static_cast<float>(numSamples);
+    }
+
+    return ramp;
+}
+
+void MixStage::beginChunk(int numSamples)
+{
+    jassert(numSamples > 0);
+
+    inputRamp  = advance(inputGain, numSamples);
+    outputRamp = advance(outputGain, numSamples);
+    dryRamp    = advance(dryGain, numSamples);
+    wetRamp    = advance(wetGain, numSamples);
+
+    balanceRamp   = advance(balance, numSamples);
+    balanceEnd    = balance.getCurrentValue();
+    balanceMoving = balanceRamp.step != 0.0f;
+
+    // Fold output gain into the crossfade gains. The product of two linear ramps is
+    // quadratic; over one chunk of a 20 ms ramp the linear approximation is inaudible.
+    const float n = static_cast<float>(numSamples);
+    const float outEnd = outputRamp.start + outputRamp.step * n;
+    const float dryEnd = (dryRamp.start + dryRamp.step * n) * outEnd;
+    const float wetEnd = (wetRamp.start + wetRamp.step * n) * outEnd;
+    dryRamp.start *= outputRamp.start;
+    wetRamp.start *= outputRamp.start;
+    dryRamp.step = (dryEnd - dryRamp.start) / n;
+    wetRamp.step = (wetEnd - wetRamp.start) / n;
+
+    snapSmoothers = false;
+}
+
+template <typename SampleType>
+void MixStage::processInput(juce::AudioBuffer<SampleType>& buffer, juce::AudioBuffer<SampleType>& dry,
+                            juce::AudioBuffer<SampleType>* reverbSend)
+{
+    const int numSamples = buffer.getNumSamples();
+    const auto start = static_cast<SampleType>(inputRamp.start);
+    const auto step  = static_cast<SampleType>(inputRamp.step);
+
+    for (int ch = 0; ch < buffer.getNumChannels(); ++ch)
+    {
+        gainAndFanOut(buffer.getWritePointer(ch),
+                      dry.getWritePointer(ch),
+                      reverbSend != nullptr ? reverbSend->getWritePointer(ch) : nullptr,
+                      numSamples, start, step);
+    }
+}
+
+template <typename SampleType>
+void MixStage::processOutput(juce::AudioBuffer<SampleType>& buffer, const juce::AudioBuffer<SampleType>& dry,
+                             const juce::AudioBuffer<SampleType>* reverbWet)
+{
+    const int numSamples = buffer.getNumSamples();
+    const auto bStart = static_cast<SampleType>(balanceRamp.start);
+    const auto bStep  = static_cast<SampleType>(balanceRamp.step);
+    const auto dStart = static_cast<SampleType>(dryRamp.start);
+    const auto dStep  = static_cast<SampleType>(dryRamp.step);
+    const auto wStart = static_cast<SampleType>(wetRamp.start);
+    const auto wStep  = static_cast<SampleType>(wetRamp.step);
+
+    for (int ch = 0; ch < buffer.getNumChannels(); ++ch)
+    {
+        if (reverbWet != nullptr)
+            blendAndCrossfade(buffer.getWritePointer(ch), reverbWet->getReadPointer(ch), dry.getReadPointer(ch),
+                              numSamples, bStart, bStep, dStart, dStep, wStart, wStep);
+        else
+            crossfade(buffer.getWritePointer(ch), dry.getReadPointer(ch), numSamples,
+                      dStart, dStep, wStart, wStep);
+    }
+}
+
+template void MixStage::processInput(juce::AudioBuffer<float>&, juce::AudioBuffer<float>&, juce::AudioBuffer<float>*);
+template void MixStage::processInput(juce::AudioBuffer<double>&, juce::AudioBuffer<double>&, juce::AudioBuffer<double>*);
+template void MixStage::processOutput(juce::AudioBuffer<float>&, const juce::AudioBuffer<float>&, const juce::AudioBuffer<float>*);
+template void MixStage::processOutput(juce::AudioBuffer<double>&, const juce::AudioBuffer<double>&, const juce::AudioBuffer<double>*);
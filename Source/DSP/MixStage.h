@@ -0,0 +1,68 @@
+#pragma once
+#include <JuceHeader.h>
+
+// Global gain staging folded into two fused sweeps over the block:
+//   processInput  — input gain, dry copy and (optionally) the parallel reverb send
+//   processOutput — parallel balance, dry/wet crossfade and output gain
+// Every gain is smoothed and applied as a linear ramp across the chunk. The gains are
+// control state shared by both precisions; only the sweeps are templated.
+class MixStage
+{
+public:
+    enum class CrossfadeLaw { Linear, EqualPower };
+
+    MixStage() = default;
+
+    void prepare(double sampleRate);
+    void setInputGain(float gain);
+    void setOutputGain(float gain);
+    void setMix(float mix);            // 0..1
+    void setBalance(float balance);    // 0 = all delay, 1 = all reverb
+    void setKillDry(bool kill);
+    void setCrossfadeLaw(CrossfadeLaw law);
+
+    // Advances all smoothers by numSamples and latches this chunk's ramps.
+    // Call once per chunk before processInput/processOutput.
+    void beginChunk(int numSamples);
+
+    // Parallel routing can skip an engine while the balance rests at an extreme
+    bool needsDelay() const noexcept  { return balanceMoving || balanceEnd < 0.99f; }
+    bool needsReverb() const noexcept { return balanceMoving || balanceEnd > 0.01f; }
+
+    // buffer *= inputGain, then fans the result out to dry (and reverbSend if given)
+    template <typename SampleType>
+    void processInput(juce::AudioBuffer<SampleType>& buffer, juce::AudioBuffer<SampleType>& dry,
+                      juce::AudioBuffer<SampleType>* reverbSend);
+
+    // buffer = outGain * (dryGain * dry + wetGain * wet), where wet is buffer alone or,
+    // when reverbWet is given, the balance blend of buffer (delay) and reverbWet
+    template <typename SampleType>
+    void processOutput(juce::AudioBuffer<SampleType>& buffer, const juce::AudioBuffer<SampleType>& dry,
+                       const juce::AudioBuffer<SampleType>* reverbWet);
+
+private:
+    struct Ramp
+    {
+        float start = 0.0f;
+        float step  = 0.0f;
+    };
+
+    static Ramp advance(juce::SmoothedValue<float>& value, int numSamples);
+    void updateCrossfadeTargets();
+
+    juce::SmoothedValue<float> inputGain  { 1.0f };
+    juce::SmoothedValue<float> outputGain { 1.0f };
+    juce::SmoothedValue<float> dryGain    { 1.0f };
+    juce::SmoothedValue<float> wetGain    { 0.0f };
+    juce::SmoothedValue<float> balance    { 0.5f };
+
+    float mixAmount = 0.0f;
+    bool killDrySignal = false;
+    CrossfadeLaw crossfadeLaw = CrossfadeLaw::Linear;
+    bool snapSmoothers = true;
+
+    // Ramps latched by beginChunk()
+    Ramp inputRamp, outputRamp, dryRamp, wetRamp, balanceRamp;
+    float balanceEnd = 0.5f;
+    bool balanceMoving = false;
+};
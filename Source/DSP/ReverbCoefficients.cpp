@@ -0,0 +1,161 @@
+#include "ReverbCoefficients.h"
+
+namespace
+{
+    constexpr double kLoFrequency = 350.0;
+    constexpr double kHiFrequency = 2000.0;
+
+    // The designs below are the RBJ cookbook filters with the same arithmetic as the
+    // juce::dsp::IIR::Coefficients makers, written out so they never allocate
+
+    BiquadCoefficients normalise(double b0, double b1, double b2, double a0, double a1, double a2)
+    {
+        const double invA0 = 1.0 / a0;
+        return { b0 * invA0, b1 * invA0, b2 * invA0, a1 * invA0, a2 * invA0 };
+    }
+
+    BiquadCoefficients makeLowShelf(double sampleRate, double frequency, double q, double gain)
+    {
+        const double A = std::sqrt(std::max(0.0, gain));
+        const double aMinus1 = A - 1.0;
+        const double aPlus1 = A + 1.0;
+        const double omega = (juce::MathConstants<double>::twoPi * frequency) / sampleRate;
+        const double coso = std::cos(omega);
+        const double beta = std::sin(omega) * std::sqrt(A) / q;
+        const double aMinus1TimesCoso = aMinus1 * coso;
+
+        return normalise(A * (aPlus1 - aMinus1TimesCoso + beta),
+                         A * 2.0 * (aMinus1 - aPlus1 * coso),
+                         A * (aPlus1 - aMinus1TimesCoso - beta),
+                         aPlus1 + aMinus1TimesCoso + beta,
+                         -2.0 * (aMinus1 + aPlus1 * coso),
+                         aPlus1 + aMinus1TimesCoso - beta);
+    }
+
+    BiquadCoefficients makeHighShelf(double sampleRate, double frequency, double q, double gain)
+    {
+        const double A = std::sqrt(std::max(0.0, gain));
+        const double aMinus1 = A - 1.0;
+        const double aPlus1 = A + 1.0;
+        const double omega = (juce::MathConstants<double>::twoPi * frequency) / sampleRate;
+        const double coso = std::cos(omega);
+        const double beta = std::sin(omega) * std::sqrt(A) / q;
+        const double aMinus1TimesCoso = aMinus1 * coso;
+
+        return normalise(A * (aPlus1 + aMinus1TimesCoso + beta),
+                         A * -2.0 * (aMinus1 + aPlus1 * coso),
+                         A * (aPlus1 + aMinus1TimesCoso - beta),
+                         aPlus1 - aMinus1TimesCoso + beta,
+                         2.0 * (aMinus1 - aPlus1 * coso),
+                         aPlus1 - aMinus1TimesCoso - beta);
+    }
+
+    BiquadCoefficients makePeakFilter(double sampleRate, double frequency, double q, double gain)
+    {
+        const double A = std::sqrt(std::max(0.0, gain));
+        const double omega = (juce::MathConstants<double>::twoPi * frequency) / sampleRate;
+        const double alpha = std::sin(omega) / (q * 2.0);
+        const double c2 = -2.0 * std::cos(omega);
+        const double alphaTimesA = alpha * A;
+        const double alphaOverA = alpha / A;
+
+        return normalise(1.0 + alphaTimesA, c2, 1.0 - alphaTimesA,
+                         1.0 + alphaOverA, c2, 1.0 - alphaOverA);
+    }
+
+    // Shelving Q follows Resonance; at the plain Q (Resonance 0) a cut never rises above 0 dB
+    constexpr double kPlainShelfQ = 0.707;
+
+    double shelfQ(const ReverbEqSettings& settings)
+    {
+        return juce::jmap(static_cast<double>(settings.resonance), 0.0, 100.0, kPlainShelfQ, 2.0);
+    }
+}
+
+ReverbCoefficientSet ReverbCoefficientSet::design(double sampleRate, const ReverbEqSettings& settings)
+{
+    ReverbCoefficientSet set;
+    set.sampleRate = sampleRate;
+    set.settings = settings;
+    designLoShelves(sampleRate, settings, set.feedbackLoShelf, set.plainLoShelf, set.outputLoShelf);
+    designHiShelves(sampleRate, settings, set.feedbackHiShelf, set.plainHiShelf, set.outputHiShelf);
+    designResonancePeaks(sampleRate, settings, set.resPeakLo, set.resPeakHi);
+    return set;
+}
+
+void ReverbCoefficientSet::designLoShelves(double sampleRate, const ReverbEqSettings& settings,
+                                           BiquadCoefficients& feedback, BiquadCoefficients& plainFeedback,
+                                           BiquadCoefficients& output)
+{
+    const double q = shelfQ(settings);
+
+    // Feedback path: cut only (std::min guarantees gain <= 0 dB in the loop)
+    double feedbackGain = juce::Decibels::decibelsToGain(std::min(static_cast<double>(settings.loEQdB), 0.0));
+    feedback = makeLowShelf(sampleRate, kLoFrequency, q, feedbackGain);
+    plainFeedback = makeLowShelf(sampleRate, kLoFrequency, kPlainShelfQ, feedbackGain);
+
+    // Output path: boost only (std::max guarantees gain >= 0 dB, outside the loop)
+    double outputGain = juce::Decibels::decibelsToGain(std::max(static_cast<double>(settings.loEQdB), 0.0));
+    output = makeLowShelf(sampleRate, kLoFrequency, q, outputGain);
+}
+
+void ReverbCoefficientSet::designHiShelves(double sampleRate, const ReverbEqSettings& settings,
+                                           BiquadCoefficients& feedback, BiquadCoefficients& plainFeedback,
+                                           BiquadCoefficients& output)
+{
+    const double q = shelfQ(settings);
+
+    // Feedback path: cut only
+    double feedbackGain = juce::Decibels::decibelsToGain(std::min(static_cast<double>(settings.hiEQdB), 0.0));
+    feedback = makeHighShelf(sampleRate, kHiFrequency, q, feedbackGain);
+    plainFeedback = makeHighShelf(sampleRate, kHiFrequency, kPlainShelfQ, feedbackGain);
+
+    // Output path: boost only
+    double outputGain = juce::Decibels::decibelsToGain(std::max(static_cast<double>(settings.hiEQdB), 0.0));
+    output = makeHighShelf(sampleRate, kHiFrequency, q, outputGain);
+}
+
+void ReverbCoefficientSet::designResonancePeaks(double sampleRate, const ReverbEqSettings& settings,
+                                                BiquadCoefficients& lo, BiquadCoefficients& hi)
+{
+
+    if (settings.resonance < kResonanceOffThreshold)
+    {
+        // Resonance off — unity gain peaks
+        lo = makePeakFilter(sampleRate, kLoFrequency, 1.0, 1.0);
+        hi = makePeakFilter(sampleRate, kHiFrequency, 1.0, 1.0);
+        return;
+    }
+
+    double q = juce::jmap(static_cast<double>(settings.resonance), 0.0, 100.0, 0.5, 6.0);
+
+    // Hard disable: any Lo EQ cut fully disables the Lo resonance peak, and vice versa
+    // for Hi. A cutting shelf and a boosting peak at the same frequency in the feedback
+    // loop interact to create net gain at the filter slopes, causing runaway.
+    double peakGainDB = resonancePeakGainDb(settings);
+    double loGainDB = (settings.loEQdB >= 0.0f) ? peakGainDB : 0.0;
+    double hiGainDB = (settings.hiEQdB >= 0.0f) ? peakGainDB : 0.0;
+
+    lo = makePeakFilter(sampleRate, kLoFrequency, q, juce::Decibels::decibelsToGain(loGainDB));
+    hi = makePeakFilter(sampleRate, kHiFrequency, q, juce::Decibels::decibelsToGain(hiGainDB));
+}
+
+double ReverbCoefficientSet::resonancePeakGainDb(const ReverbEqSettings& settings)
+{
+    if (settings.resonance < kResonanceOffThreshold)
+        return 0.0;
+
+    // Base max gain scales inversely with feedback (prevents loop compounding)
+    double maxGainDB = juce::jmap(static_cast<double>(settings.feedbackAmount), 0.0, 0.85, 6.0, 1.5);
+    return juce::jmap(static_cast<double>(settings.resonance), 0.0, 100.0, 0.0, maxGainDB);
+}
+
+BiquadCoefficients ReverbCoefficientSet::interpolate(const BiquadCoefficients& a, const BiquadCoefficients& b, double t)
+{
+    auto lerp = [t](double x, double y) { return x + t * (y - x); };
+
+    const double k2 = lerp(a[4], b[4]);
+    const double k1 = lerp(a[3] / (1.0 + a[4]), b[3] / (1.0 + b[4]));
+
+    return { lerp(a[0], b[0]), lerp(a[1], b[1]), lerp(a[2], b[2]), k1 * (1.0 + k2), k2 };
+}
@@ -0,0 +1,72 @@
+#pragma once
+#include <JuceHeader.h>
+#include <array>
+
+// Biquad coefficients in JUCE's normalised order: b0, b1, b2, a1, a2
+using BiquadCoefficients = std::array<double, 5>;
+
+// The reverb parameters every EQ / resonance biquad depends on
+struct ReverbEqSettings
+{
+    float loEQdB = 0.0f;
+    float hiEQdB = 0.0f;
+    float resonance = 0.0f;        // Percent
+    float feedbackAmount = 0.0f;   // Loop gain, see feedbackPercentToAmount()
+
+    bool operator==(const ReverbEqSettings& other) const
+    {
+        return loEQdB == other.loEQdB && hiEQdB == other.hiEQdB
+            && resonance == other.resonance && feedbackAmount == other.feedbackAmount;
+    }
+
+    static float feedbackPercentToAmount(float percent)
+    {
+        return juce::jlimit(0.0f, 0.85f, (percent / 100.0f) * 0.85f);
+    }
+};
+
+// Every EQ / resonance biquad of the reverb for one sample rate and setting.
+// The designers are plain math and never allocate, so the engine can use them on the
+// audio thread; a full set is normally built on the message thread (parameter changes,
+// preset recall) and installed by ReverbEngine::installCoefficients() as a plain copy.
+struct ReverbCoefficientSet
+{
+    double sampleRate = 0.0;
+    ReverbEqSettings settings;
+
+    BiquadCoefficients feedbackLoShelf {};
+    BiquadCoefficients outputLoShelf {};
+    BiquadCoefficients feedbackHiShelf {};
+    BiquadCoefficients outputHiShelf {};
+    BiquadCoefficients resPeakLo {};
+    BiquadCoefficients resPeakHi {};
+
+    // The feedback cuts at the plain shelf Q, for loops with no headroom: the Resonance Q
+    // overshoots 0 dB next to the corner (up to +5.5 dB at full Resonance and -12 dB)
+    BiquadCoefficients plainLoShelf {};
+    BiquadCoefficients plainHiShelf {};
+
+    static ReverbCoefficientSet design(double sampleRate, const ReverbEqSettings& settings);
+
+    // Per-group designers, shared with the engine's incremental updates
+    static void designLoShelves(double sampleRate, const ReverbEqSettings& settings,
+                                BiquadCoefficients& feedback, BiquadCoefficients& plainFeedback,
+                                BiquadCoefficients& output);
+    static void designHiShelves(double sampleRate, const ReverbEqSettings& settings,
+                                BiquadCoefficients& feedback, BiquadCoefficients& plainFeedback,
+                                BiquadCoefficients& output);
+    static void designResonancePeaks(double sampleRate, const ReverbEqSettings& settings,
+                                     BiquadCoefficients& lo, BiquadCoefficients& hi);
+
+    // Gain of the resonance peaks at their centre (both the same; 0 with Resonance off)
+    static double resonancePeakGainDb(const ReverbEqSettings& settings);
+
+    // Blends two biquads in the lattice (reflection-coefficient) domain: the
+    // denominator a1, a2 maps to k1 = a1 / (1 + a2), k2 = a2, which lie inside
+    // (-1, 1) for every stable filter. Interpolating k1, k2 therefore keeps every
+    // intermediate filter stable; the numerator is interpolated directly.
+    static BiquadCoefficients interpolate(const BiquadCoefficients& a, const BiquadCoefficients& b, double t);
+
+    // Resonance below this is treated as off and the peaks are unity gain
+    static constexpr float kResonanceOffThreshold = 0.5f;
+};
@@ -1,446 +1,671 @@
 #include "ReverbEngine.h"
+#include "Smoothing.h"
+#include "FastMath.h"
 
-ReverbEngine::ReverbEngine()
+namespace
+{
+    // Ramp lengths for the smoothed parameters
+    constexpr double kSizeRampSeconds     = 0.1;
+    constexpr double kGravityRampSeconds  = 0.1;
+    constexpr double kFeedbackRampSeconds = 0.05;
+
+    // Pre-delay samples cleared in each sleeping block (allpasses go one per block)
+    constexpr size_t kClearSliceSize = 8192;
+
+    // Allpass coefficient and per-stage decay gain for a Gravity setting
+    template <typename T>
+    void gravityToAllpass(float gravity, T& g, T& decay)
+    {
+        const T x = static_cast<T>(gravity);
+        if (gravity >= 0.0f)
+        {
+            g     = juce::jmap(x, T(0), T(100), T(0.6), T(0.7));
+            decay = juce::jmap(x, T(0), T(100), T(0.99997), T(0.999995));
+        }
+        else
+        {
+            g     = juce::jmap(x, T(-100), T(0), T(-0.7), T(0.6));
+            decay = juce::jmap(x, T(-100), T(0), T(0.99990), T(0.99997));
+        }
+    }
+
+    // Initial LFO phase of a per-output allpass. Chains 0 and 1 keep the original stereo
+    // quadrature; further chains continue in quarter turns.
+    float initialChainPhase(int chain, int stage, int numStages)
+    {
+        const float phase = (juce::MathConstants<float>::twoPi * stage) / numStages
+                          + juce::MathConstants<float>::halfPi * chain;
+        return chain < 2 ? phase : std::fmod(phase, juce::MathConstants<float>::twoPi);
+    }
+}
+
+template <typename SampleType, typename Tier>
+ReverbEngine<SampleType, Tier>::ReverbEngine()
 {
-    prevFeedbackL = 0.0f;
-    prevFeedbackR = 0.0f;
     feedbackAmount = 0.0f;
     modDepthSamples = 0.0f;
-    lfoPhaseInc = 0.0f;
     preDelaySamples = 0.0f;
     preDelayWritePos = 0;
     isFrozen = false;
     killDrySignal = false;
-    currentLoEQdB = 0.0f;
-    currentHiEQdB = 0.0f;
-    currentResonance = 0.0f;
-    resonanceQ = 0.707f;
-
-    for (int i = 0; i < kNumSharedAllpasses; ++i)
-        sharedLfoPhases[i] = (juce::MathConstants<float>::twoPi * i) / kNumSharedAllpasses;
-
-    for (int i = 0; i < kNumChannelAllpasses; ++i)
-    {
-        leftLfoPhases[i]  = (juce::MathConstants<float>::twoPi * i) / kNumChannelAllpasses;
-        rightLfoPhases[i] = (juce::MathConstants<float>::twoPi * i) / kNumChannelAllpasses
-                            + juce::MathConstants<float>::halfPi;
-    }
 }
 
-void ReverbEngine::prepare(double sampleRate, int samplesPerBlock)
+template <typename SampleType, typename Tier>
+void ReverbEngine<SampleType, Tier>::prepare(double sampleRate, int samplesPerBlock, int numOutputChannels)
 {
+    jassert(numOutputChannels <= kMaxOutputChannels);
+    numChains = juce::jlimit(1, kMaxOutputChannels, numOutputChannels);
     currentSampleRate = sampleRate;
     sampleRateScale = static_cast<float>(sampleRate / 44100.0);
 
+    numLanes = SimdLanes::paddedLanes<SampleType>(numChains);
+
+    // Shared chain: one line and LFO per stage
+    int sharedMaxDelays[kNumSharedAllpasses];
+    float sharedPhases[kNumSharedAllpasses];
     for (int i = 0; i < kNumSharedAllpasses; ++i)
     {
-        int baseDelay = sharedDelays[i];
-        int maxDelay = static_cast<int>(baseDelay * sampleRateScale * 1.3f);
-        sharedAllpasses[i].init(maxDelay);
-        sharedAllpasses[i].prepare(sampleRate);
-        sharedAllpasses[i].setDelay(baseDelay * sampleRateScale * currentSize);
+        sharedMaxDelays[i] = static_cast<int>(Tier::sharedDelays[i] * sampleRateScale * 1.3f);
+        sharedPhases[i] = (juce::MathConstants<float>::twoPi * i) / kNumSharedAllpasses;
     }
 
-    for (int i = 0; i < kNumChannelAllpasses; ++i)
+    // Per-output chains, lane-major. Padding lanes are never read or written, so they
+    // get a token line and no LFO.
+    constexpr int kPaddingLineSamples = 4;
+    int chainMaxDelays[kNumChannelAllpasses * kMaxLanes];
+    float chainPhases[kNumChannelAllpasses * kMaxOutputChannels];
+    for (int c = 0; c < numLanes; ++c)
     {
-        int lBase = leftDelays[i];
-        int lMax  = static_cast<int>(lBase * sampleRateScale * 1.3f);
-        leftAllpasses[i].init(lMax);
-        leftAllpasses[i].prepare(sampleRate);
-        leftAllpasses[i].setDelay(lBase * sampleRateScale * currentSize);
-
-        int rBase = rightDelays[i];
-        int rMax  = static_cast<int>(rBase * sampleRateScale * 1.3f);
-        rightAllpasses[i].init(rMax);
-        rightAllpasses[i].prepare(sampleRate);
-        rightAllpasses[i].setDelay(rBase * sampleRateScale * currentSize);
+        for (int i = 0; i < kNumChannelAllpasses; ++i)
+        {
+            const bool real = c < numChains;
+            chainMaxDelays[chainStage(c, i)] = real ? static_cast<int>(Tier::channelDelays[c][i] * sampleRateScale * 1.3f)
+                                                    : kPaddingLineSamples;
+            if (real)
+                chainPhases[chainLfo(c, i)] = initialChainPhase(c, i, kNumChannelAllpasses);
+        }
     }
 
+    sharedAllpasses.init(sharedMaxDelays, kNumSharedAllpasses);
+    chainAllpasses.init(chainMaxDelays, kNumChannelAllpasses * numLanes);
+    sharedLfos.init(sharedPhases, kNumSharedAllpasses);
+    chainLfos.init(chainPhases, kNumChannelAllpasses * numChains);
+
+    applySize(currentSize);
+    applyGravity(currentGravity);
+
     // Pre-delay buffer
     int preDelaySize = juce::nextPowerOfTwo(kMaxPreDelaySamples);
     preDelayBuffer.resize(preDelaySize, 0.0f);
     preDelayMask = preDelaySize - 1;
     preDelayWritePos = 0;
 
-    juce::dsp::ProcessSpec spec{sampleRate, static_cast<juce::uint32>(samplesPerBlock), 1};
-
-    // Feedback path filters
-    feedbackDampingL.prepare(spec);
-    feedbackDampingR.prepare(spec);
-    feedbackHPL.prepare(spec);
-    feedbackHPR.prepare(spec);
-    resPeakLoL.prepare(spec);
-    resPeakLoR.prepare(spec);
-    resPeakHiL.prepare(spec);
-    resPeakHiR.prepare(spec);
-    feedbackLoShelfL.prepare(spec);
-    feedbackLoShelfR.prepare(spec);
-    feedbackHiShelfL.prepare(spec);
-    feedbackHiShelfR.prepare(spec);
-
-    // Output path filters
-    outputLoShelfL.prepare(spec);
-    outputLoShelfR.prepare(spec);
-    outputHiShelfL.prepare(spec);
-    outputHiShelfR.prepare(spec);
-
-    // Feedback damping: LP at 10kHz (hi roll-off) + HP at 80Hz (lo roll-off)
-    auto lpCoeffs = juce::dsp::IIR::Coefficients<float>::makeFirstOrderLowPass(sampleRate, 10000.0f);
-    feedbackDampingL.coefficients = lpCoeffs;
-    feedbackDampingR.coefficients = lpCoeffs;
-
-    auto hpCoeffs = juce::dsp::IIR::Coefficients<float>::makeHighPass(sampleRate, 80.0f);
-    feedbackHPL.coefficients = hpCoeffs;
-    feedbackHPR.coefficients = hpCoeffs;
-
-    // Initialize EQ and resonance to flat
-    resonanceQ = 0.707f;
-    currentResonance = 0.0f;
-    setLoEQ(0.0f);
-    setHiEQ(0.0f);
-    setResonance(0.0f);
+    filters.prepare(sampleRate);
+
+    sizeSmoothed.reset(sampleRate, kSizeRampSeconds);
+    gravitySmoothed.reset(sampleRate, kGravityRampSeconds);
+    feedbackSmoothed.reset(sampleRate, kFeedbackRampSeconds);
+    snapSmoothers = true;
 
     reset();
 }
 
-void ReverbEngine::setGravity(float gravity)
+template <typename SampleType, typename Tier>
+void ReverbEngine<SampleType, Tier>::setGravity(float gravity)
 {
-    float g, decay;
-    if (gravity >= 0.0f)
-    {
-        g     = juce::jmap(gravity, 0.0f, 100.0f, 0.6f, 0.7f);
-        decay = juce::jmap(gravity, 0.0f, 100.0f, 0.99997f, 0.999995f);
-    }
-    else
-    {
-        g     = juce::jmap(gravity, -100.0f, 0.0f, -0.7f, 0.6f);
-        decay = juce::jmap(gravity, -100.0f, 0.0f, 0.99990f, 0.99997f);
-    }
+    currentGravity = gravity;
+    setSmoothedTarget(gravitySmoothed, gravity, snapSmoothers);
+    if (snapSmoothers)
+        applyGravity(gravity);
+}
 
-    for (int i = 0; i < kNumSharedAllpasses; ++i)
-    {
-        sharedAllpasses[i].setCoefficient(g);
-        sharedAllpasses[i].setDecayGain(decay);
-    }
-    for (int i = 0; i < kNumChannelAllpasses; ++i)
+template <typename SampleType, typename Tier>
+void ReverbEngine<SampleType, Tier>::applyGravity(float gravity)
+{
+    SampleType g, decay;
+    gravityToAllpass(gravity, g, decay);
+
+    for (auto* bank : { &sharedAllpasses, &chainAllpasses })
     {
-        leftAllpasses[i].setCoefficient(g);
-        leftAllpasses[i].setDecayGain(decay);
-        rightAllpasses[i].setCoefficient(g);
-        rightAllpasses[i].setDecayGain(decay);
+        for (int i = 0; i < bank->getNumStages(); ++i)
+        {
+            bank->setCoefficient(i, g);
+            bank->setDecayGain(i, decay);
+        }
     }
 }
 
-void ReverbEngine::setSize(float size)
+template <typename SampleType, typename Tier>
+void ReverbEngine<SampleType, Tier>::setSize(float size)
 {
     float scaleFactor = juce::jlimit(0.05f, 1.3f, size / 100.0f);
+    if (scaleFactor == currentSize)
+        return;
+
     currentSize = scaleFactor;
+    setSmoothedTarget(sizeSmoothed, scaleFactor, snapSmoothers);
+    if (snapSmoothers)
+        applySize(scaleFactor);
+}
+
+template <typename SampleType, typename Tier>
+void ReverbEngine<SampleType, Tier>::applySize(float scaleFactor)
+{
+    const float scale = sampleRateScale * scaleFactor;
 
     for (int i = 0; i < kNumSharedAllpasses; ++i)
-        sharedAllpasses[i].setDelay(sharedDelays[i] * sampleRateScale * currentSize);
+        sharedAllpasses.setDelay(i, Tier::sharedDelays[i] * scale);
 
-    for (int i = 0; i < kNumChannelAllpasses; ++i)
-    {
-        leftAllpasses[i].setDelay(leftDelays[i]   * sampleRateScale * currentSize);
-        rightAllpasses[i].setDelay(rightDelays[i] * sampleRateScale * currentSize);
-    }
+    for (int c = 0; c < numChains; ++c)
+        for (int i = 0; i < kNumChannelAllpasses; ++i)
+            chainAllpasses.setDelay(chainStage(c, i), Tier::channelDelays[c][i] * scale);
 }
 
-void ReverbEngine::setPreDelay(float ms)
+template <typename SampleType, typename Tier>
+void ReverbEngine<SampleType, Tier>::setPreDelay(float ms)
 {
     preDelaySamples = juce::jlimit(0.0f, static_cast<float>(kMaxPreDelaySamples - 1),
                                    (ms / 1000.0f) * static_cast<float>(currentSampleRate));
 }
 
-void ReverbEngine::setFeedback(float percent)
+template <typename SampleType, typename Tier>
+void ReverbEngine<SampleType, Tier>::setFeedback(float percent)
 {
-    feedbackAmount = juce::jlimit(0.0f, 0.85f, (percent / 100.0f) * 0.85f);
-    updateResonancePeaks();
+    float amount = ReverbEqSettings::feedbackPercentToAmount(percent);
+    if (amount == feedbackAmount)
+        return;
+
+    feedbackAmount = amount;
+    setSmoothedTarget(feedbackSmoothed, amount, snapSmoothers);
+    filters.setFeedbackAmount(amount);
 }
 
-void ReverbEngine::setModulation(float depthPercent, float rateHz)
+template <typename SampleType, typename Tier>
+void ReverbEngine<SampleType, Tier>::setModulation(float depthPercent, float rateHz)
 {
     modDepthSamples = juce::jmap(depthPercent, 0.0f, 100.0f, 0.0f, 12.0f);
-    lfoPhaseInc = (rateHz * juce::MathConstants<float>::twoPi) / static_cast<float>(currentSampleRate);
+    const float increment = (rateHz * juce::MathConstants<float>::twoPi) / static_cast<float>(currentSampleRate);
+    sharedLfos.setPhaseIncrement(increment);
+    chainLfos.setPhaseIncrement(increment);
 }
 
-void ReverbEngine::setLoEQ(float dB)
+template <typename SampleType, typename Tier>
+void ReverbEngine<SampleType, Tier>::setLoEQ(float dB)
 {
-    currentLoEQdB = dB;
+    filters.setLoEQ(dB);
+}
 
-    // Feedback path: cut only (std::min guarantees gain <= 0 dB in the loop)
-    float feedbackGain = juce::Decibels::decibelsToGain(std::min(dB, 0.0f));
-    auto fbCoeffs = juce::dsp::IIR::Coefficients<float>::makeLowShelf(
-        currentSampleRate, 350.0f, resonanceQ, feedbackGain);
-    feedbackLoShelfL.coefficients = fbCoeffs;
-    feedbackLoShelfR.coefficients = fbCoeffs;
+template <typename SampleType, typename Tier>
+void ReverbEngine<SampleType, Tier>::setHiEQ(float dB)
+{
+    filters.setHiEQ(dB);
+}
 
-    // Output path: boost only (std::max guarantees gain >= 0 dB, outside the loop)
-    float outputGain = juce::Decibels::decibelsToGain(std::max(dB, 0.0f));
-    auto outCoeffs = juce::dsp::IIR::Coefficients<float>::makeLowShelf(
-        currentSampleRate, 350.0f, resonanceQ, outputGain);
-    outputLoShelfL.coefficients = outCoeffs;
-    outputLoShelfR.coefficients = outCoeffs;
+template <typename SampleType, typename Tier>
+void ReverbEngine<SampleType, Tier>::setResonance(float percent)
+{
+    filters.setResonance(percent);
+}
+
+template <typename SampleType, typename Tier>
+void ReverbEngine<SampleType, Tier>::updateCoefficients()
+{
+    filters.updateCoefficients();
+}
 
-    // Resonance peak gain at 350 Hz must be scaled back when Lo EQ is cutting
-    updateResonancePeaks();
+template <typename SampleType, typename Tier>
+bool ReverbEngine<SampleType, Tier>::installCoefficients(const ReverbCoefficientSet& set)
+{
+    return filters.installCoefficients(set);
 }
 
-void ReverbEngine::setHiEQ(float dB)
+template <typename SampleType, typename Tier>
+void ReverbEngine<SampleType, Tier>::interpolateCoefficients(const ReverbCoefficientSet& a,
+                                                             const ReverbCoefficientSet& b, float t)
 {
-    currentHiEQdB = dB;
+    filters.interpolateCoefficients(a, b, t);
+}
 
-    // Feedback path: cut only
-    float feedbackGain = juce::Decibels::decibelsToGain(std::min(dB, 0.0f));
-    auto fbCoeffs = juce::dsp::IIR::Coefficients<float>::makeHighShelf(
-        currentSampleRate, 2000.0f, resonanceQ, feedbackGain);
-    feedbackHiShelfL.coefficients = fbCoeffs;
-    feedbackHiShelfR.coefficients = fbCoeffs;
+template <typename SampleType, typename Tier>
+void ReverbEngine<SampleType, Tier>::invalidateCoefficients()
+{
+    filters.invalidateCoefficients();
+}
 
-    // Output path: boost only
-    float outputGain = juce::Decibels::decibelsToGain(std::max(dB, 0.0f));
-    auto outCoeffs = juce::dsp::IIR::Coefficients<float>::makeHighShelf(
-        currentSampleRate, 2000.0f, resonanceQ, outputGain);
-    outputHiShelfL.coefficients = outCoeffs;
-    outputHiShelfR.coefficients = outCoeffs;
+template <typename SampleType, typename Tier>
+void ReverbEngine<SampleType, Tier>::setFreeze(bool frozen)
+{
+    isFrozen = frozen;
+}
 
-    // Resonance peak gain at 2000 Hz must be scaled back when Hi EQ is cutting
-    updateResonancePeaks();
+template <typename SampleType, typename Tier>
+void ReverbEngine<SampleType, Tier>::setKillDry(bool kill)
+{
+    killDrySignal = kill;
 }
 
-void ReverbEngine::setResonance(float percent)
+template <typename SampleType, typename Tier>
+void ReverbEngine<SampleType, Tier>::updateControlRate(int numSamples)
 {
-    currentResonance = percent;
-    // Update shelving Q first so the shelf coefficients use the right Q when
-    // setLoEQ/setHiEQ are called below. Those calls also invoke updateResonancePeaks,
-    // so we don't need to call it separately here.
-    resonanceQ = juce::jmap(percent, 0.0f, 100.0f, 0.707f, 2.0f);
-    setLoEQ(currentLoEQdB);   // Updates shelves + peaks
-    setHiEQ(currentHiEQdB);   // Updates shelves + peaks
+    // Size and Gravity touch every allpass, so they only move once per control block
+    if (sizeSmoothed.isSmoothing())
+        applySize(sizeSmoothed.skip(numSamples));
+
+    if (gravitySmoothed.isSmoothing())
+        applyGravity(gravitySmoothed.skip(numSamples));
 }
 
-void ReverbEngine::updateResonancePeaks()
+template <typename SampleType, typename Tier>
+void ReverbEngine<SampleType, Tier>::render(SampleType* const* channels, int numOutputs, int numSamples)
 {
-    if (currentResonance < 0.5f)
+    const SampleType outputScale = SampleType(1) / static_cast<SampleType>(numOutputs);
+    const int numChainLfos = kNumChannelAllpasses * numChains;
+
+    // One sample per chain, side by side
+    alignas(SimdLanes::kAlignment) SampleType lanes[kMaxLanes];
+
+    for (int blockStart = 0; blockStart < numSamples; blockStart += kControlBlockSize)
     {
-        // Resonance off — unity gain peaks
-        auto flatLo = juce::dsp::IIR::Coefficients<float>::makePeakFilter(
-            currentSampleRate, 350.0f, 1.0f, 1.0f);
-        resPeakLoL.coefficients = flatLo;
-        resPeakLoR.coefficients = flatLo;
-
-        auto flatHi = juce::dsp::IIR::Coefficients<float>::makePeakFilter(
-            currentSampleRate, 2000.0f, 1.0f, 1.0f);
-        resPeakHiL.coefficients = flatHi;
-        resPeakHiR.coefficients = flatHi;
+        const int blockEnd = std::min(numSamples, blockStart + kControlBlockSize);
+        updateControlRate(blockEnd - blockStart);
+        sharedLfos.advance(blockEnd - blockStart, kNumSharedAllpasses);
+        chainLfos.advance(blockEnd - blockStart, numChainLfos);
+
+        for (int n = blockStart; n < blockEnd; ++n)
+        {
+            // 1. Sum the input channels to mono
+            SampleType monoIn = channels[0][n];
+            for (int c = 1; c < numOutputs; ++c)
+                monoIn += channels[c][n];
+            if (numOutputs > 1)
+                monoIn *= outputScale;
+
+            // 2. Build feedback signal by running every chain's prev output through the
+            //    damping chain (freeze bypasses all damping)
+            SampleType actualFeedback = feedbackSmoothed.getNextValue();
+            std::copy(prevFeedback, prevFeedback + numLanes, lanes);
+
+            // Band-limiting (LP at 10kHz, HP at 80Hz), then the resonance peaks that boost
+            // selected frequencies in the loop (causes them to ring longer), then the
+            // cut-only EQ shelves — whichever of them are not unity
+            if (!isFrozen)
+                filters.processFeedback(lanes, numLanes);
+
+            SampleType feedbackSum = SampleType(0);
+            for (int c = 0; c < numOutputs; ++c)
+                feedbackSum += lanes[c];
+
+            // 3. Freeze kills new input and holds a very high feedback
+            if (isFrozen)
+            {
+                actualFeedback = SampleType(0.995);
+                monoIn = SampleType(0);
+            }
+
+            // 4. Inject damped feedback (averaged over the chains to keep it mono before the
+            //    allpass chain)
+            if (numOutputs > 1)
+                monoIn += feedbackSum * outputScale * actualFeedback;
+            else
+                monoIn += feedbackSum * actualFeedback;
+
+            // 5. Soft-clip before the allpass chain (tanh to within 7e-6, see FastMath)
+            monoIn = FastMath::tanh(monoIn);
+
+            // 6. Pre-delay
+            preDelayBuffer[preDelayWritePos & preDelayMask] = monoIn;
+            int delayOffset = static_cast<int>(preDelaySamples);
+            int readIdx = (preDelayWritePos - delayOffset + static_cast<int>(preDelayBuffer.size())) & preDelayMask;
+            monoIn = preDelayBuffer[readIdx];
+            preDelayWritePos = (preDelayWritePos + 1) & preDelayMask;
+
+            // 7. Modulation and delayed reads for every allpass stage, in one pass per bank
+            const float depth = isFrozen ? 0.0f : modDepthSamples;
+            sharedLfos.render(sharedModOffsets, kNumSharedAllpasses, depth);
+            chainLfos.render(chainModOffsets, numChainLfos, depth);
+            sharedAllpasses.prepareSample(sharedModOffsets, kNumSharedAllpasses);
+            chainAllpasses.template prepareLanes<kNumChannelAllpasses>(chainModOffsets, 0, numLanes, numChains);
+
+            // 8. Shared allpass chain (mono) — runs once whatever the output count
+            const SampleType signal = sharedAllpasses.template process<kNumSharedAllpasses>(0, monoIn);
+
+            // 9. Per-output allpass chains (decorrelated split), all chains at once
+            std::fill(lanes, lanes + numLanes, signal);
+            chainAllpasses.template processLanes<kNumChannelAllpasses>(0, numLanes, numChains, lanes);
+
+            // 10. Store output for next feedback iteration BEFORE output EQ
+            //    (output EQ boost should not re-enter the feedback loop)
+            std::copy(lanes, lanes + numLanes, prevFeedback);
+
+            // 11. Output EQ (boost only — safe outside feedback loop)
+            filters.processOutput(lanes, numLanes);
+
+            for (int c = 0; c < numOutputs; ++c)
+            {
+                // 12. Safety clamp + NaN protection
+                SampleType out = std::clamp(lanes[c], SampleType(-4), SampleType(4));
+                if (std::isnan(out) || std::isinf(out)) out = SampleType(0);
+                out += SampleType(1e-25);  // denormal prevention
+
+                // 13. Write output
+                channels[c][n] = out;
+            }
+
+            sharedAllpasses.advance();
+            chainAllpasses.advance();
+        }
+    }
+}
+
+template <typename SampleType, typename Tier>
+void ReverbEngine<SampleType, Tier>::process(juce::AudioBuffer<SampleType>& buffer)
+{
+    const int numSamples  = buffer.getNumSamples();
+    const int numChannels = buffer.getNumChannels();
+
+    if (numChannels == 0)
         return;
+
+    const bool inputSilent = SilenceDetector::isSilent(buffer);
+
+    if (sleeping)
+    {
+        if (inputSilent)
+        {
+            // Tail has died away and nothing new is coming in — output silence and keep tidying up
+            skipSmoothing();
+            clearNextSlice();
+            buffer.clear();
+            return;
+        }
+
+        wakeUp();
     }
 
-    float q = juce::jmap(currentResonance, 0.0f, 100.0f, 0.5f, 6.0f);
+    // One chain per output channel; channels beyond the prepared count stay silent
+    jassert(numChannels <= numChains);
+    const int outputs = std::min(numChannels, numChains);
+    for (int ch = outputs; ch < numChannels; ++ch)
+        buffer.clear(ch, 0, numSamples);
 
-    // Base max gain scales inversely with feedback (prevents loop compounding)
-    float maxGainDB = juce::jmap(feedbackAmount, 0.0f, 0.85f, 6.0f, 1.5f);
+    if (clearingStale)
+        clearStaleAhead(numSamples);
 
-    // Hard disable: any Lo EQ cut fully disables the Lo resonance peak, and vice versa
-    // for Hi. A cutting shelf and a boosting peak at the same frequency in the feedback
-    // loop interact to create net gain at the filter slopes, causing runaway.
-    float loGainDB = (currentLoEQdB >= 0.0f)
-        ? juce::jmap(currentResonance, 0.0f, 100.0f, 0.0f, maxGainDB)
-        : 0.0f;
-    float hiGainDB = (currentHiEQdB >= 0.0f)
-        ? juce::jmap(currentResonance, 0.0f, 100.0f, 0.0f, maxGainDB)
-        : 0.0f;
+    render(buffer.getArrayOfWritePointers(), outputs, numSamples);
 
-    auto loCoeffs = juce::dsp::IIR::Coefficients<float>::makePeakFilter(
-        currentSampleRate, 350.0f, q, juce::Decibels::decibelsToGain(loGainDB));
-    resPeakLoL.coefficients = loCoeffs;
-    resPeakLoR.coefficients = loCoeffs;
+    snapSmoothers = false;
 
-    auto hiCoeffs = juce::dsp::IIR::Coefficients<float>::makePeakFilter(
-        currentSampleRate, 2000.0f, q, juce::Decibels::decibelsToGain(hiGainDB));
-    resPeakHiL.coefficients = hiCoeffs;
-    resPeakHiR.coefficients = hiCoeffs;
+    // A frozen tail never decays, so only a free-running one may go to sleep
+    silenceDetector.setHoldSamples(longestPathSamples());
+    if (silenceDetector.update(inputSilent, buffer) && !isFrozen && sleepEnabled)
+        enterSleep();
 }
 
-void ReverbEngine::setFreeze(bool frozen)
+template <typename SampleType, typename Tier>
+int ReverbEngine<SampleType, Tier>::longestPathSamples() const
 {
-    isFrozen = frozen;
+    // Pre-delay, then the shared chain, then the longest output chain
+    int shared = 0;
+    for (int i = 0; i < kNumSharedAllpasses; ++i)
+        shared += Tier::sharedDelays[i];
+
+    const float size = std::max(currentSize, sizeSmoothed.getCurrentValue());
+    const float chain = (static_cast<float>(shared) + longestChannelChain()) * sampleRateScale * size;
+    return static_cast<int>(preDelaySamples + chain + modDepthSamples * 2.0f) + kControlBlockSize;
 }
 
-void ReverbEngine::setKillDry(bool kill)
+template <typename SampleType, typename Tier>
+float ReverbEngine<SampleType, Tier>::longestChannelChain() const
 {
-    killDrySignal = kill;
+    int longest = 0;
+    for (int c = 0; c < numChains; ++c)
+    {
+        int length = 0;
+        for (int i = 0; i < kNumChannelAllpasses; ++i)
+            length += Tier::channelDelays[c][i];
+        longest = std::max(longest, length);
+    }
+
+    return static_cast<float>(longest);
 }
 
-void ReverbEngine::process(juce::AudioBuffer<float>& buffer)
+template <typename SampleType, typename Tier>
+double ReverbEngine<SampleType, Tier>::getTailLengthSeconds() const
 {
-    const int numSamples  = buffer.getNumSamples();
-    const int numChannels = buffer.getNumChannels();
+    if (isFrozen)
+        return std::numeric_limits<double>::infinity();
 
-    if (numChannels == 0)
-        return;
+    float g, decay;
+    gravityToAllpass(currentGravity, g, decay);
 
-    auto* leftData  = buffer.getWritePointer(0);
-    auto* rightData = numChannels > 1 ? buffer.getWritePointer(1) : leftData;
+    // Decay range to cover: down to the sleep threshold, plus whatever the output shelves add
+    const float rangeDb = -SilenceDetector::kThresholdDb + filters.getOutputBoostDb();
 
-    for (int n = 0; n < numSamples; ++n)
+    // Samples for a loop with gain `gain` per `period` samples to fall by rangeDb
+    auto decaySamples = [rangeDb](float gain, float period) -> float
     {
-        // 1. Sum stereo input to mono
-        float monoIn = (leftData[n] + rightData[n]) * 0.5f;
+        gain = std::abs(gain);
+        if (gain < 1.0e-6f)
+            return 0.0f;
+        return period * rangeDb / (-20.0f * std::log10(std::min(gain, 0.99999f)));
+    };
+
+    const float scale = sampleRateScale * currentSize;
+
+    // Each allpass rings on its own with pole radius |g * decay| per delay period;
+    // the longest delay line rings the longest.
+    float longestDelay = 0.0f;
+    for (int c = 0; c < numChains; ++c)
+        for (int i = 0; i < kNumChannelAllpasses; ++i)
+            longestDelay = std::max(longestDelay, static_cast<float>(Tier::channelDelays[c][i]));
+    const float ringSamples = decaySamples(g * decay, longestDelay * scale);
+
+    // Outer loop: one trip through pre-delay, the shared chain and an output chain.
+    // A lossy allpass has gain between |d - g| / |1 - g d| and |d + g| / |1 + g d|;
+    // take the larger per stage. Damping filters only cut, so they are ignored.
+    const float stageGain = std::max(std::abs(decay - g) / std::abs(1.0f - g * decay),
+                                     std::abs(decay + g) / std::abs(1.0f + g * decay));
+    const float loopGain = feedbackAmount
+                         * std::pow(stageGain, static_cast<float>(kNumSharedAllpasses + kNumChannelAllpasses));
+    const float loopSamples = static_cast<float>(longestPathSamples());
+    const float feedbackSamples = decaySamples(loopGain, loopSamples);
+
+    return static_cast<double>(loopSamples + ringSamples + feedbackSamples) / currentSampleRate;
+}
 
-        // 2. Build feedback signal by running prev output through damping chain
-        float actualFeedback = feedbackAmount;
-        float feedbackL, feedbackR;
+template <typename SampleType, typename Tier>
+void ReverbEngine<SampleType, Tier>::enterSleep()
+{
+    sleeping = true;
+    clearStep = 0;
+    numClearSteps = kNumSharedAllpasses + kNumChannelAllpasses
+                  + static_cast<int>((preDelayBuffer.size() + kClearSliceSize - 1) / kClearSliceSize)
+                  + 1;   // Last step resets the filters and feedback state
+    silenceDetector.reset();
+
+    // The sleeping blocks clear everything from here
+    endStaleRegions();
+}
 
-        if (isFrozen)
-        {
-            // Freeze: very high feedback, bypass all damping
-            actualFeedback = 0.995f;
-            feedbackL = prevFeedbackL;
-            feedbackR = prevFeedbackR;
-        }
-        else
+template <typename SampleType, typename Tier>
+void ReverbEngine<SampleType, Tier>::wakeUp()
+{
+    // Nothing from before is heard again, so ramps set up since the last silent block (or
+    // by ReverbSection bringing a stale engine up to date) can jump to their targets
+    skipSmoothing();
+
+    // The allpasses and pre-delay slices the sleeping blocks did not get to are cleared
+    // ahead of the reads from here on, so the cost stays with the blocks that read them
+    if (clearStep < numClearSteps)
+    {
+        const int numAllpassSteps = kNumSharedAllpasses + kNumChannelAllpasses;
+
+        for (int step = clearStep; step < numAllpassSteps; ++step)
         {
-            // Normal: full damping chain
-            // Band-limiting: LP at 10kHz (hi roll-off) + HP at 80Hz (lo roll-off)
-            feedbackL = feedbackDampingL.processSample(prevFeedbackL);
-            feedbackL = feedbackHPL.processSample(feedbackL);
-            // Resonance peaks boost selected frequencies in the loop (causes them to ring longer)
-            feedbackL = resPeakLoL.processSample(feedbackL);
-            feedbackL = resPeakHiL.processSample(feedbackL);
-            // Cut-only EQ shelves (user Lo/Hi EQ, negative dB only)
-            feedbackL = feedbackLoShelfL.processSample(feedbackL);
-            feedbackL = feedbackHiShelfL.processSample(feedbackL);
-
-            feedbackR = feedbackDampingR.processSample(prevFeedbackR);
-            feedbackR = feedbackHPR.processSample(feedbackR);
-            feedbackR = resPeakLoR.processSample(feedbackR);
-            feedbackR = resPeakHiR.processSample(feedbackR);
-            feedbackR = feedbackLoShelfR.processSample(feedbackR);
-            feedbackR = feedbackHiShelfR.processSample(feedbackR);
+            if (step < kNumSharedAllpasses)
+                staleShared[step].begin(sharedAllpasses.getWriteCounter());
+            else
+                for (int c = 0; c < numChains; ++c)
+                    staleChain[chainStage(c, step - kNumSharedAllpasses)].begin(chainAllpasses.getWriteCounter());
         }
 
-        // 3. Freeze kills new input
-        if (isFrozen)
-            monoIn = 0.0f;
+        if (clearStep < numClearSteps - 1)
+            stalePreDelay.begin(static_cast<juce::uint32>(preDelayWritePos));
 
-        // 4. Inject damped feedback (average L+R to keep it mono before the allpass chain)
-        monoIn += (feedbackL + feedbackR) * 0.5f * actualFeedback;
+        resetFilters();
 
-        // 5. Soft-clip before the allpass chain
-        monoIn = std::tanh(monoIn);
-
-        // 6. Pre-delay
-        preDelayBuffer[preDelayWritePos & preDelayMask] = monoIn;
-        int delayOffset = static_cast<int>(preDelaySamples);
-        int readIdx = (preDelayWritePos - delayOffset + static_cast<int>(preDelayBuffer.size())) & preDelayMask;
-        monoIn = preDelayBuffer[readIdx];
-        preDelayWritePos = (preDelayWritePos + 1) & preDelayMask;
+        clearStep = numClearSteps;
+        clearingStale = true;
+    }
 
-        // 7. Shared allpass chain (mono)
-        float signal = monoIn;
-        for (int i = 0; i < kNumSharedAllpasses; ++i)
-        {
-            float lfo = std::sin(sharedLfoPhases[i]) * modDepthSamples;
-            sharedLfoPhases[i] += lfoPhaseInc;
-            if (sharedLfoPhases[i] >= juce::MathConstants<float>::twoPi)
-                sharedLfoPhases[i] -= juce::MathConstants<float>::twoPi;
+    sleeping = false;
+    silenceDetector.reset();
+}
 
-            sharedAllpasses[i].setModOffset(isFrozen ? 0.0f : lfo);
-            signal = sharedAllpasses[i].processSampleModulated(signal);
-        }
+template <typename SampleType, typename Tier>
+void ReverbEngine<SampleType, Tier>::clearStaleAhead(int numSamples)
+{
+    // Size ramps towards its target over the block; the allpasses read anywhere between
+    // the lengths at its start and end, give or take the modulation
+    auto sizeAtEnd = sizeSmoothed;
+    const float sizeFrom = sizeSmoothed.getCurrentValue();
+    const float sizeTo = sizeAtEnd.skip(numSamples);
+    const float shortest = std::min(sizeFrom, sizeTo) * sampleRateScale;
+    const float longest = std::max(sizeFrom, sizeTo) * sampleRateScale;
+
+    bool stale = false;
+    for (int i = 0; i < kNumSharedAllpasses; ++i)
+    {
+        if (!staleShared[i].isActive())
+            continue;
 
-        // 8. Per-channel allpass chains (stereo split)
-        float left  = signal;
-        float right = signal;
+        const float base = static_cast<float>(Tier::sharedDelays[i]);
+        sharedAllpasses.clearStaleAhead(i, staleShared[i], numSamples,
+                                        base * shortest - modDepthSamples, base * longest + modDepthSamples);
+        stale = stale || staleShared[i].isActive();
+    }
 
+    for (int c = 0; c < numChains; ++c)
+    {
         for (int i = 0; i < kNumChannelAllpasses; ++i)
         {
-            float lfoL = std::sin(leftLfoPhases[i]) * modDepthSamples;
-            leftLfoPhases[i] += lfoPhaseInc;
-            if (leftLfoPhases[i] >= juce::MathConstants<float>::twoPi)
-                leftLfoPhases[i] -= juce::MathConstants<float>::twoPi;
-            leftAllpasses[i].setModOffset(isFrozen ? 0.0f : lfoL);
-            left = leftAllpasses[i].processSampleModulated(left);
-
-            float lfoR = std::sin(rightLfoPhases[i]) * modDepthSamples;
-            rightLfoPhases[i] += lfoPhaseInc;
-            if (rightLfoPhases[i] >= juce::MathConstants<float>::twoPi)
-                rightLfoPhases[i] -= juce::MathConstants<float>::twoPi;
-            rightAllpasses[i].setModOffset(isFrozen ? 0.0f : lfoR);
-            right = rightAllpasses[i].processSampleModulated(right);
+            auto& region = staleChain[chainStage(c, i)];
+            if (!region.isActive())
+                continue;
+
+            const float base = static_cast<float>(Tier::channelDelays[c][i]);
+            chainAllpasses.clearStaleAhead(chainStage(c, i), region, numSamples,
+                                           base * shortest - modDepthSamples, base * longest + modDepthSamples);
+            stale = stale || region.isActive();
         }
+    }
 
-        // 9. Store output for next feedback iteration BEFORE output EQ
-        //    (output EQ boost should not re-enter the feedback loop)
-        prevFeedbackL = left;
-        prevFeedbackR = right;
+    stalePreDelay.clearAhead(preDelayBuffer.data(), static_cast<juce::uint32>(preDelayMask), numSamples,
+                             preDelaySamples, preDelaySamples);
 
-        // 10. Output EQ (boost only — safe outside feedback loop)
-        left  = outputLoShelfL.processSample(left);
-        left  = outputHiShelfL.processSample(left);
-        right = outputLoShelfR.processSample(right);
-        right = outputHiShelfR.processSample(right);
+    clearingStale = stale || stalePreDelay.isActive();
+}
 
-        // 11. Safety clamp + NaN protection
-        left  = std::clamp(left,  -4.0f, 4.0f);
-        right = std::clamp(right, -4.0f, 4.0f);
+template <typename SampleType, typename Tier>
+void ReverbEngine<SampleType, Tier>::endStaleRegions()
+{
+    for (auto& region : staleShared)
+        region.end();
 
-        if (std::isnan(left)  || std::isinf(left))  left  = 0.0f;
-        if (std::isnan(right) || std::isinf(right)) right = 0.0f;
+    for (auto& region : staleChain)
+        region.end();
 
-        left  += 1e-25f;  // denormal prevention
-        right += 1e-25f;
+    stalePreDelay.end();
+    clearingStale = false;
+}
 
-        // 12. Write output
-        leftData[n]  = left;
-        rightData[n] = right;
+template <typename SampleType, typename Tier>
+bool ReverbEngine<SampleType, Tier>::clearNextSlice()
+{
+    if (clearStep >= numClearSteps)
+        return true;
+
+    const int step = clearStep++;
+    const int numAllpassSteps = kNumSharedAllpasses + kNumChannelAllpasses;
+
+    if (step < kNumSharedAllpasses)
+    {
+        sharedAllpasses.resetStage(step);
+    }
+    else if (step < numAllpassSteps)
+    {
+        for (int c = 0; c < numChains; ++c)
+            chainAllpasses.resetStage(chainStage(c, step - kNumSharedAllpasses));
+    }
+    else if (step < numClearSteps - 1)
+    {
+        const size_t start = static_cast<size_t>(step - numAllpassSteps) * kClearSliceSize;
+        const size_t end   = std::min(preDelayBuffer.size(), start + kClearSliceSize);
+        std::fill(preDelayBuffer.begin() + static_cast<std::ptrdiff_t>(start),
+                  preDelayBuffer.begin() + static_cast<std::ptrdiff_t>(end), 0.0f);
+    }
+    else
+    {
+        resetFilters();
     }
+
+    return clearStep >= numClearSteps;
 }
 
-void ReverbEngine::reset()
+template <typename SampleType, typename Tier>
+void ReverbEngine<SampleType, Tier>::skipSmoothing()
 {
-    for (int i = 0; i < kNumSharedAllpasses; ++i)
-        sharedAllpasses[i].reset();
-    for (int i = 0; i < kNumChannelAllpasses; ++i)
+    // Nothing is audible while asleep, so parameter ramps can jump to their targets
+    if (sizeSmoothed.isSmoothing())
+    {
+        sizeSmoothed.setCurrentAndTargetValue(sizeSmoothed.getTargetValue());
+        applySize(sizeSmoothed.getTargetValue());
+    }
+
+    if (gravitySmoothed.isSmoothing())
     {
-        leftAllpasses[i].reset();
-        rightAllpasses[i].reset();
+        gravitySmoothed.setCurrentAndTargetValue(gravitySmoothed.getTargetValue());
+        applyGravity(gravitySmoothed.getTargetValue());
     }
 
+    feedbackSmoothed.setCurrentAndTargetValue(feedbackSmoothed.getTargetValue());
+    snapSmoothers = false;
+}
+
+template <typename SampleType, typename Tier>
+void ReverbEngine<SampleType, Tier>::resetFilters()
+{
+    filters.reset();
+
+    std::fill(std::begin(prevFeedback), std::end(prevFeedback), SampleType(0));
+}
+
+template <typename SampleType, typename Tier>
+void ReverbEngine<SampleType, Tier>::reset()
+{
+    sharedAllpasses.reset();
+    chainAllpasses.reset();
+
     std::fill(preDelayBuffer.begin(), preDelayBuffer.end(), 0.0f);
     preDelayWritePos = 0;
 
-    // Reset feedback path filters
-    feedbackDampingL.reset();
-    feedbackDampingR.reset();
-    feedbackHPL.reset();
-    feedbackHPR.reset();
-    resPeakLoL.reset();
-    resPeakLoR.reset();
-    resPeakHiL.reset();
-    resPeakHiR.reset();
-    feedbackLoShelfL.reset();
-    feedbackLoShelfR.reset();
-    feedbackHiShelfL.reset();
-    feedbackHiShelfR.reset();
-
-    // Reset output path filters
-    outputLoShelfL.reset();
-    outputLoShelfR.reset();
-    outputHiShelfL.reset();
-    outputHiShelfR.reset();
-
-    prevFeedbackL = 0.0f;
-    prevFeedbackR = 0.0f;
+    // Reset feedback and output path filters
+    resetFilters();
 
-    for (int i = 0; i < kNumSharedAllpasses; ++i)
-        sharedLfoPhases[i] = (juce::MathConstants<float>::twoPi * i) / kNumSharedAllpasses;
+    sharedLfos.reset();
+    chainLfos.reset();
 
-    for (int i = 0; i < kNumChannelAllpasses; ++i)
-    {
-        leftLfoPhases[i]  = (juce::MathConstants<float>::twoPi * i) / kNumChannelAllpasses;
-        rightLfoPhases[i] = (juce::MathConstants<float>::twoPi * i) / kNumChannelAllpasses
-                            + juce::MathConstants<float>::halfPi;
-    }
+    // Everything is clear, so start asleep until the first non-silent block
+    sleeping = true;
+    clearStep = 0;
+    numClearSteps = 0;
+    silenceDetector.reset();
+    endStaleRegions();
 }
+
+template class ReverbEngine<float, ReverbTiers::Eco>;
+template class ReverbEngine<float, ReverbTiers::Standard>;
+template class ReverbEngine<float, ReverbTiers::Ultra>;
+template class ReverbEngine<double, ReverbTiers::Eco>;
+template class ReverbEngine<double, ReverbTiers::Standard>;
+template class ReverbEngine<double, ReverbTiers::Ultra>;
@@ -1,13 +1,29 @@
 #pragma once
 #include <JuceHeader.h>
-#include "FilterUtils.h"
+#include "AllpassBank.h"
+#include "LfoBank.h"
+#include "SilenceDetector.h"
+#include "ReverbFilters.h"
+#include "ReverbTiers.h"
+#include <array>
 
+// Templated on the audio sample type and on the allpass topology (one of ReverbTiers);
+// instantiated for float and double with every tier in ReverbEngine.cpp. Parameters and
+// modulation stay float, the signal path and all filter/delay state run at SampleType.
+//
+// One mono input chain (pre-delay + shared allpasses) feeds a decorrelated allpass chain per
+// output channel, so surround and immersive layouts only add per-channel chains rather
+// than whole engines. Channels 0 and 1 are the original stereo pair. The per-output chains
+// and their filters run side by side as SIMD lanes, one lane per output.
+template <typename SampleType, typename Tier>
 class ReverbEngine
 {
 public:
     ReverbEngine();
 
-    void prepare(double sampleRate, int samplesPerBlock);
+    static constexpr int kMaxOutputChannels = ReverbTiers::kMaxOutputChannels;
+
+    void prepare(double sampleRate, int samplesPerBlock, int numOutputChannels);
     void setGravity(float gravity);
     void setSize(float size);
     void setPreDelay(float ms);
@@ -18,78 +34,137 @@ public:
     void setResonance(float percent);
     void setFreeze(bool frozen);
     void setKillDry(bool kill);
-    void process(juce::AudioBuffer<float>& buffer);
+
+    // Rebuilds only the coefficient groups invalidated by the setters since the
+    // last call. Call once after a batch of setter calls, before process().
+    void updateCoefficients();
+
+    // Installs a coefficient set precomputed off the audio thread. Only a set built for
+    // the engine's current sample rate and EQ settings is accepted (returns false
+    // otherwise); it replaces every coefficient group and clears the pending rebuilds.
+    bool installCoefficients(const ReverbCoefficientSet& set);
+
+    // Morphing: installs the lattice-domain blend of two precomputed sets (t = 0 → a,
+    // t = 1 → b) and clears the pending rebuilds. A fixed, allocation-free cost per call.
+    void interpolateCoefficients(const ReverbCoefficientSet& a, const ReverbCoefficientSet& b, float t);
+
+    // Marks every coefficient group for a rebuild from the current settings (after
+    // interpolated coefficients no longer apply)
+    void invalidateCoefficients();
+
+    void process(juce::AudioBuffer<SampleType>& buffer);
     void reset();
 
+    // True while the engine is idle on silence (see process())
+    bool isSleeping() const noexcept { return sleeping; }
+
+    // Off keeps the engine running on silence, e.g. to render a tail below the sleep threshold
+    void setSleepEnabled(bool enabled) noexcept { sleepEnabled = enabled; }
+
+    // Last feedback-loop sample per output channel (0 = left), for metering loop energy
+    float getFeedbackSample(int channel) const noexcept
+    {
+        return static_cast<float>(prevFeedback[channel]);
+    }
+
+    // Estimated time for the tail to decay below the sleep threshold after the
+    // input stops, from the current targets. Infinite while frozen.
+    double getTailLengthSeconds() const;
+
 private:
-    // Updates only the resonance peak filter coefficients.
-    // Called from setResonance, setFeedback, setLoEQ, and setHiEQ.
-    // Does NOT touch shelving filters — avoids infinite recursion.
-    void updateResonancePeaks();
-    static constexpr int kNumSharedAllpasses = 6;      // Shorter mono chain → faster onset
-    static constexpr int kNumChannelAllpasses = 10;    // Longer per-channel chains → density
+    // Control-rate smoothing: Size and Gravity are re-applied to the allpasses once
+    // every kControlBlockSize samples, Feedback ramps per sample (it is just a gain).
+    // The modulation LFOs also step once per control block.
+    void updateControlRate(int numSamples);
+    void applySize(float scaleFactor);
+    void applyGravity(float gravity);
+    static constexpr int kControlBlockSize = 32;
+
+    // Per-sample loop writing `numOutputs` channels (at most numChains)
+    void render(SampleType* const* channels, int numOutputs, int numSamples);
+
+    // Sleep on silence: once input and tail are below threshold the engine stops
+    // running and clears its delay lines one slice per sleeping block. Whatever is left
+    // at a wake-up is cleared ahead of the reads (StaleRegion).
+    void enterSleep();
+    void wakeUp();
+    bool clearNextSlice();
+    void clearStaleAhead(int numSamples);
+    void endStaleRegions();
+    void skipSmoothing();
+    int longestPathSamples() const;
+    float longestChannelChain() const;
+
+    static constexpr int kNumSharedAllpasses = Tier::kNumSharedAllpasses;
+    static constexpr int kNumChannelAllpasses = Tier::kNumChannelAllpasses;
     static constexpr int kMaxPreDelaySamples = 96000;
 
-    // Delay lengths at 44.1kHz (in samples) — all prime numbers for incoherent reflections
-    static constexpr int sharedDelays[kNumSharedAllpasses] = {
-        1049, 1223, 1429, 1597, 1777, 1951
-    };
-    static constexpr int leftDelays[kNumChannelAllpasses] = {
-        1051, 1249, 1453, 1627, 1801, 1979, 2153, 2333, 2521, 2699
-    };
-    static constexpr int rightDelays[kNumChannelAllpasses] = {
-        1063, 1259, 1471, 1637, 1811, 1997, 2161, 2351, 2539, 2713
-    };
-
-    // Allpass chains
-    AllPassDelay sharedAllpasses[kNumSharedAllpasses];
-    AllPassDelay leftAllpasses[kNumChannelAllpasses];
-    AllPassDelay rightAllpasses[kNumChannelAllpasses];
+    // Per-output state is held lane-major: lane c belongs to output c, and lanes past
+    // numChains pad the count to whole SIMD registers. Padding lanes only ride along in
+    // the vector kernels: they have no LFO, their delayed reads are never prepared and
+    // their lines never written, and they are never heard.
+    static constexpr int kMaxLanes = 16;
+    static_assert(kMaxLanes >= SimdLanes::paddedLanes<SampleType>(kMaxOutputChannels), "Too few lanes");
+    static_assert(kMaxLanes <= AllpassBank<SampleType>::kMaxLanes && kMaxLanes <= ReverbFilters<SampleType>::kMaxLanes,
+                  "Lane kernels are too narrow");
+
+    int numChains = 2;             // Chains prepared (output channels)
+    int numLanes = 2;              // numChains padded to the SIMD width
+
+    // Shared allpass chain (mono), and every per-output stage in a second bank where
+    // stage i of chain c sits at i * numLanes + c
+    AllpassBank<SampleType> sharedAllpasses;
+    AllpassBank<SampleType> chainAllpasses;
+    int chainStage(int chain, int stage) const noexcept { return stage * numLanes + chain; }
+
+    // One modulation LFO per allpass stage, advanced once per control block, and the
+    // resulting per-sample delay offsets. The chain LFOs cover real chains only, packed:
+    // stage i of chain c is chainLfo(c, i).
+    LfoBank sharedLfos;
+    LfoBank chainLfos;
+    int chainLfo(int chain, int stage) const noexcept { return stage * numChains + chain; }
+    float sharedModOffsets[kNumSharedAllpasses] {};
+    float chainModOffsets[kNumChannelAllpasses * kMaxOutputChannels] {};
 
     // Pre-delay
-    std::vector<float> preDelayBuffer;
+    std::vector<SampleType> preDelayBuffer;
     size_t preDelayMask = 0;
     int preDelayWritePos = 0;
     float preDelaySamples = 0.0f;
 
-    // Feedback path filters (applied every iteration — cuts only, never boost)
-    juce::dsp::IIR::Filter<float> feedbackDampingL;      // LP at 10kHz — hi decay
-    juce::dsp::IIR::Filter<float> feedbackDampingR;
-    juce::dsp::IIR::Filter<float> feedbackHPL;           // HP at 80Hz — lo decay
-    juce::dsp::IIR::Filter<float> feedbackHPR;
-    juce::dsp::IIR::Filter<float> resPeakLoL;            // Resonance peak at 350 Hz
-    juce::dsp::IIR::Filter<float> resPeakLoR;
-    juce::dsp::IIR::Filter<float> resPeakHiL;            // Resonance peak at 2000 Hz
-    juce::dsp::IIR::Filter<float> resPeakHiR;
-    juce::dsp::IIR::Filter<float> feedbackLoShelfL;      // Lo shelf cut-only
-    juce::dsp::IIR::Filter<float> feedbackLoShelfR;
-    juce::dsp::IIR::Filter<float> feedbackHiShelfL;      // Hi shelf cut-only
-    juce::dsp::IIR::Filter<float> feedbackHiShelfR;
-
-    // Output path filters (applied once before output — boost only, safe outside loop)
-    juce::dsp::IIR::Filter<float> outputLoShelfL;
-    juce::dsp::IIR::Filter<float> outputLoShelfR;
-    juce::dsp::IIR::Filter<float> outputHiShelfL;
-    juce::dsp::IIR::Filter<float> outputHiShelfR;
-
-    // LFO phases (one per allpass)
-    float sharedLfoPhases[kNumSharedAllpasses];
-    float leftLfoPhases[kNumChannelAllpasses];
-    float rightLfoPhases[kNumChannelAllpasses];
+    // Feedback and output filters, one lane per chain
+    ReverbFilters<SampleType> filters;
+    void resetFilters();
+
+    // Each chain's output from the previous sample, fed back through the filters
+    alignas(SimdLanes::kAlignment) SampleType prevFeedback[kMaxLanes] {};
+
+    // Smoothed parameters (targets live in currentSize / feedbackAmount)
+    juce::SmoothedValue<float> sizeSmoothed { 1.0f };
+    juce::SmoothedValue<float> gravitySmoothed;
+    juce::SmoothedValue<float> feedbackSmoothed;
+    bool snapSmoothers = true;     // Setters jump to target until the first process() after prepare()
 
     // State variables
     double currentSampleRate = 44100.0;
     float sampleRateScale = 1.0f;
     float currentSize = 1.0f;
+    float currentGravity = 0.0f;
     float modDepthSamples = 0.0f;
-    float lfoPhaseInc = 0.0f;
     float feedbackAmount = 0.0f;
-    float prevFeedbackL = 0.0f;
-    float prevFeedbackR = 0.0f;
-    float currentLoEQdB = 0.0f;
-    float currentHiEQdB = 0.0f;
-    float currentResonance = 0.0f;
-    float resonanceQ = 0.707f;
     bool isFrozen = false;
     bool killDrySignal = false;
+
+    SilenceDetector silenceDetector;
+    bool sleeping = false;
+    bool sleepEnabled = true;
+    int clearStep = 0;             // Next allpass / pre-delay slice to clear while asleep
+    int numClearSteps = 0;         // 0 when nothing is left to clear
+
+    // Allpass lines (indexed as in the banks) and pre-delay still holding samples from
+    // before the last wake-up
+    StaleRegion staleShared[kNumSharedAllpasses];
+    StaleRegion staleChain[kNumChannelAllpasses * kMaxLanes];
+    StaleRegion stalePreDelay;
+    bool clearingStale = false;
 };
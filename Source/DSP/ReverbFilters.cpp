@@ -0,0 +1,248 @@
+#include "ReverbFilters.h"
+
+namespace
+{
+    // JUCE coefficients (second order, or first order with b2 = a2 = 0) as b0, b1, b2, a1, a2
+    BiquadCoefficients toBiquad(const juce::dsp::IIR::Coefficients<double>& coefficients)
+    {
+        const auto* raw = coefficients.getRawCoefficients();
+        if (coefficients.getFilterOrder() == 1)
+            return { raw[0], raw[1], 0.0, raw[2], 0.0 };
+        return { raw[0], raw[1], raw[2], raw[3], raw[4] };
+    }
+}
+
+template <typename SampleType>
+void ReverbFilters<SampleType>::prepare(double sampleRate)
+{
+    currentSampleRate = sampleRate;
+
+    // Feedback damping: LP at 10kHz (hi roll-off) + HP at 80Hz (lo roll-off)
+    using DesignCoefficients = juce::dsp::IIR::Coefficients<double>;
+    feedbackChain.setSection(dampingSection, toBiquad(*DesignCoefficients::makeFirstOrderLowPass(sampleRate, 10000.0)));
+    feedbackChain.setSection(highPassSection, toBiquad(*DesignCoefficients::makeHighPass(sampleRate, 80.0)));
+
+    // Rebuild every coefficient group for the new sample rate with the current settings
+    // (the damping and high-pass sections are compiled in with them)
+    invalidateCoefficients();
+    updateCoefficients();
+    reset();
+}
+
+template <typename SampleType>
+void ReverbFilters<SampleType>::setLoEQ(float dB)
+{
+    if (dB == settings.loEQdB)
+        return;
+
+    // Any Lo EQ cut disables the Lo resonance peak, so only a sign change affects it
+    if ((dB >= 0.0f) != (settings.loEQdB >= 0.0f))
+        peaksDirty = true;
+
+    settings.loEQdB = dB;
+    loShelvesDirty = true;
+}
+
+template <typename SampleType>
+void ReverbFilters<SampleType>::setHiEQ(float dB)
+{
+    if (dB == settings.hiEQdB)
+        return;
+
+    if ((dB >= 0.0f) != (settings.hiEQdB >= 0.0f))
+        peaksDirty = true;
+
+    settings.hiEQdB = dB;
+    hiShelvesDirty = true;
+}
+
+template <typename SampleType>
+void ReverbFilters<SampleType>::setResonance(float percent)
+{
+    if (percent == settings.resonance)
+        return;
+
+    settings.resonance = percent;
+    // Shelving Q follows Resonance, so both shelf groups need the new Q as well as the peaks
+    loShelvesDirty = true;
+    hiShelvesDirty = true;
+    peaksDirty = true;
+}
+
+template <typename SampleType>
+void ReverbFilters<SampleType>::setFeedbackAmount(float amount)
+{
+    if (amount == settings.feedbackAmount)
+        return;
+
+    settings.feedbackAmount = amount;
+    peaksDirty = true;   // Peak gain scales inversely with feedback
+}
+
+template <typename SampleType>
+void ReverbFilters<SampleType>::updateCoefficients()
+{
+    if (!loShelvesDirty && !hiShelvesDirty && !peaksDirty)
+        return;
+
+    if (loShelvesDirty)
+    {
+        updateLoShelves();
+        loShelvesDirty = false;
+    }
+
+    if (hiShelvesDirty)
+    {
+        updateHiShelves();
+        hiShelvesDirty = false;
+    }
+
+    if (peaksDirty)
+    {
+        updateResonancePeaks();
+        peaksDirty = false;
+    }
+
+    compileChains();
+}
+
+template <typename SampleType>
+void ReverbFilters<SampleType>::compileChains() noexcept
+{
+    feedbackChain.compile();
+    outputChain.compile();
+}
+
+template <typename SampleType>
+float ReverbFilters<SampleType>::getOutputBoostDb() const noexcept
+{
+    const float shelves = std::max({ settings.loEQdB, settings.hiEQdB, 0.0f });
+    if (placement == ResonancePlacement::inLoop)
+        return shelves;
+
+    return shelves + static_cast<float>(ReverbCoefficientSet::resonancePeakGainDb(settings));
+}
+
+template <typename SampleType>
+void ReverbFilters<SampleType>::setPeaks(const BiquadCoefficients& lo, const BiquadCoefficients& hi)
+{
+    if (placement == ResonancePlacement::inLoop)
+    {
+        feedbackChain.setSection(resPeakLoSection, lo);
+        feedbackChain.setSection(resPeakHiSection, hi);
+    }
+    else
+    {
+        outputChain.setSection(outputResPeakLoSection, lo);
+        outputChain.setSection(outputResPeakHiSection, hi);
+    }
+}
+
+template <typename SampleType>
+const BiquadCoefficients& ReverbFilters<SampleType>::loopLoShelf(const ReverbCoefficientSet& set) const noexcept
+{
+    return placement == ResonancePlacement::inLoop ? set.feedbackLoShelf : set.plainLoShelf;
+}
+
+template <typename SampleType>
+const BiquadCoefficients& ReverbFilters<SampleType>::loopHiShelf(const ReverbCoefficientSet& set) const noexcept
+{
+    return placement == ResonancePlacement::inLoop ? set.feedbackHiShelf : set.plainHiShelf;
+}
+
+template <typename SampleType>
+void ReverbFilters<SampleType>::updateLoShelves()
+{
+    BiquadCoefficients feedback, plainFeedback, output;
+    ReverbCoefficientSet::designLoShelves(currentSampleRate, settings, feedback, plainFeedback, output);
+    feedbackChain.setSection(feedbackLoShelfSection, placement == ResonancePlacement::inLoop ? feedback : plainFeedback);
+    outputChain.setSection(outputLoShelfSection, output);
+}
+
+template <typename SampleType>
+void ReverbFilters<SampleType>::updateHiShelves()
+{
+    BiquadCoefficients feedback, plainFeedback, output;
+    ReverbCoefficientSet::designHiShelves(currentSampleRate, settings, feedback, plainFeedback, output);
+    feedbackChain.setSection(feedbackHiShelfSection, placement == ResonancePlacement::inLoop ? feedback : plainFeedback);
+    outputChain.setSection(outputHiShelfSection, output);
+}
+
+template <typename SampleType>
+void ReverbFilters<SampleType>::updateResonancePeaks()
+{
+    const bool flat = settings.resonance < ReverbCoefficientSet::kResonanceOffThreshold;
+
+    // Resonance off — unity gain peaks (feedback/EQ changes cannot alter them)
+    if (flat && peaksAreFlat)
+        return;
+
+    BiquadCoefficients lo, hi;
+    ReverbCoefficientSet::designResonancePeaks(currentSampleRate, settings, lo, hi);
+    setPeaks(lo, hi);
+    peaksAreFlat = flat;
+}
+
+template <typename SampleType>
+bool ReverbFilters<SampleType>::installCoefficients(const ReverbCoefficientSet& set)
+{
+    if (set.sampleRate != currentSampleRate || !(set.settings == settings))
+        return false;
+
+    feedbackChain.setSection(feedbackLoShelfSection, loopLoShelf(set));
+    outputChain.setSection(outputLoShelfSection, set.outputLoShelf);
+    feedbackChain.setSection(feedbackHiShelfSection, loopHiShelf(set));
+    outputChain.setSection(outputHiShelfSection, set.outputHiShelf);
+    setPeaks(set.resPeakLo, set.resPeakHi);
+
+    compileChains();
+
+    peaksAreFlat = settings.resonance < ReverbCoefficientSet::kResonanceOffThreshold;
+    loShelvesDirty = false;
+    hiShelvesDirty = false;
+    peaksDirty = false;
+    return true;
+}
+
+template <typename SampleType>
+void ReverbFilters<SampleType>::interpolateCoefficients(const ReverbCoefficientSet& a,
+                                                        const ReverbCoefficientSet& b, float t)
+{
+    const double x = static_cast<double>(t);
+    auto blend = [x](const BiquadCoefficients& from, const BiquadCoefficients& to)
+    {
+        return ReverbCoefficientSet::interpolate(from, to, x);
+    };
+
+    feedbackChain.setSection(feedbackLoShelfSection, blend(loopLoShelf(a), loopLoShelf(b)));
+    outputChain.setSection(outputLoShelfSection, blend(a.outputLoShelf, b.outputLoShelf));
+    feedbackChain.setSection(feedbackHiShelfSection, blend(loopHiShelf(a), loopHiShelf(b)));
+    outputChain.setSection(outputHiShelfSection, blend(a.outputHiShelf, b.outputHiShelf));
+    setPeaks(blend(a.resPeakLo, b.resPeakLo), blend(a.resPeakHi, b.resPeakHi));
+
+    compileChains();
+
+    peaksAreFlat = false;
+    loShelvesDirty = false;
+    hiShelvesDirty = false;
+    peaksDirty = false;
+}
+
+template <typename SampleType>
+void ReverbFilters<SampleType>::invalidateCoefficients()
+{
+    loShelvesDirty = true;
+    hiShelvesDirty = true;
+    peaksDirty = true;
+    peaksAreFlat = false;
+}
+
+template <typename SampleType>
+void ReverbFilters<SampleType>::reset()
+{
+    feedbackChain.reset();
+    outputChain.reset();
+}
+
+template class ReverbFilters<float>;
+template class ReverbFilters<double>;
@@ -0,0 +1,112 @@
+#pragma once
+#include <JuceHeader.h>
+#include "FilterUtils.h"
+#include "ReverbCoefficients.h"
+
+// The reverb's loop and output filters, run on one lane per channel (or delay line) and
+// shared by every reverb algorithm. Templated on the sample type; instantiated for float
+// and double in ReverbFilters.cpp.
+//
+// Feedback path (applied every iteration — cuts only, never boost): damping LP, HP, the
+// two resonance peaks and the cut-only EQ shelves. Output path (applied once before
+// output — boost only, safe outside the loop): the boost-only EQ shelves. Unity sections
+// (Resonance off, EQ at 0 dB) are compiled out, so at default settings only the damping
+// and high-pass run.
+//
+// The peaks and the Resonance Q of the cut shelves rise above 0 dB, which the loop gain
+// has to make room for. ReverbEngine's tops out at 0.85; an FDN line passes up to all of
+// its signal, so for the FDN the peaks move to the output path and the loop cuts use the
+// plain shelf Q, leaving a feedback path that never exceeds unity at any setting.
+template <typename SampleType>
+class ReverbFilters
+{
+public:
+    enum class ResonancePlacement
+    {
+        inLoop,        // Peaks and resonant shelf Q in the feedback path
+        onOutput       // Peaks in the output path, feedback path at or below 0 dB
+    };
+
+    explicit ReverbFilters(ResonancePlacement resonancePlacement = ResonancePlacement::inLoop)
+        : placement(resonancePlacement) {}
+
+    static constexpr int kMaxLanes = LaneBiquadChain<SampleType>::kMaxLanes;
+
+    // Designs the fixed damping sections and rebuilds every EQ group for the sample rate
+    void prepare(double sampleRate);
+
+    void setLoEQ(float dB);
+    void setHiEQ(float dB);
+    void setResonance(float percent);
+    void setFeedbackAmount(float amount);      // Loop gain, see ReverbEqSettings
+    const ReverbEqSettings& getSettings() const noexcept { return settings; }
+
+    // Most the output path lifts any frequency by, for tail length estimates
+    float getOutputBoostDb() const noexcept;
+
+    // Rebuilds only the coefficient groups invalidated by the setters since the last call
+    void updateCoefficients();
+
+    // Installs a precomputed set; refused (returns false) unless it was built for the
+    // current sample rate and settings. Replaces every EQ group and clears pending rebuilds.
+    bool installCoefficients(const ReverbCoefficientSet& set);
+
+    // Installs the lattice-domain blend of two precomputed sets (t = 0 → a, t = 1 → b)
+    void interpolateCoefficients(const ReverbCoefficientSet& a, const ReverbCoefficientSet& b, float t);
+
+    // Marks every EQ group for a rebuild from the current settings
+    void invalidateCoefficients();
+
+    // Filter `numLanes` lanes in place (see LaneBiquadChain::process())
+    void processFeedback(SampleType* lanes, int numLanes) noexcept { feedbackChain.process(lanes, numLanes); }
+    void processOutput(SampleType* lanes, int numLanes) noexcept   { outputChain.process(lanes, numLanes); }
+
+    void reset();
+
+private:
+    // Coefficient groups — each is rebuilt at most once per updateCoefficients()
+    void updateLoShelves();
+    void updateHiShelves();
+    // Resonance peaks depend on Resonance, Feedback and the sign of Lo/Hi EQ
+    void updateResonancePeaks();
+
+    // Rebuilds both chain programs after their sections changed
+    void compileChains() noexcept;
+
+    // Feedback path sections, in processing order
+    enum FeedbackSection
+    {
+        dampingSection,            // LP at 10kHz — hi decay
+        highPassSection,           // HP at 80Hz — lo decay
+        resPeakLoSection,          // Resonance peak at 350 Hz
+        resPeakHiSection,          // Resonance peak at 2000 Hz
+        feedbackLoShelfSection,    // Lo shelf cut-only
+        feedbackHiShelfSection,    // Hi shelf cut-only
+        numFeedbackSections
+    };
+    LaneBiquadChain<SampleType> feedbackChain;
+    static_assert(numFeedbackSections <= LaneBiquadChain<SampleType>::kMaxSections, "Too many sections");
+
+    // Output path sections; the peaks only with ResonancePlacement::onOutput
+    enum OutputSection
+    {
+        outputLoShelfSection,
+        outputHiShelfSection,
+        outputResPeakLoSection,
+        outputResPeakHiSection
+    };
+    LaneBiquadChain<SampleType> outputChain;
+
+    // Stores the peaks in the path the placement puts them in, and picks its loop cuts
+    void setPeaks(const BiquadCoefficients& lo, const BiquadCoefficients& hi);
+    const BiquadCoefficients& loopLoShelf(const ReverbCoefficientSet& set) const noexcept;
+    const BiquadCoefficients& loopHiShelf(const ReverbCoefficientSet& set) const noexcept;
+
+    ResonancePlacement placement;
+    double currentSampleRate = 44100.0;
+    ReverbEqSettings settings;
+    bool loShelvesDirty = true;
+    bool hiShelvesDirty = true;
+    bool peaksDirty = true;
+    bool peaksAreFlat = false;     // Unity peaks already installed — skip rebuilding them
+};
@@ -0,0 +1,511 @@
+#include "ReverbSection.h"
+#include "FastMath.h"
+
+namespace
+{
+    // Capture: the impulse is kept small so the soft-clip stays linear (tanh(x) = x to
+    // within x^2 / 3)
+    constexpr double kCaptureImpulse = 1.0e-3;
+}
+
+template <typename SampleType>
+int ReverbSection<SampleType>::decimationFor(double sampleRate, int tailRate)
+{
+    int factor = 1 << juce::jlimit(0, numTailRates - 1, tailRate);
+    while (factor > 1 && sampleRate / factor < kMinTailSampleRate)
+        factor /= 2;
+
+    return factor;
+}
+
+template <typename SampleType>
+void ReverbSection<SampleType>::prepare(double sampleRate, int samplesPerBlock, int numOutputChannels, int decimation)
+{
+    resampler.prepare(decimation, numOutputChannels, samplesPerBlock);
+    resamplerLatencyMs = static_cast<float>(1000.0 * resampler.getLatencySamples() / sampleRate);
+
+    tailSampleRate = sampleRate / decimation;
+    const int tailBlockSize = HalfBandResampler<SampleType>::lowRateBlockSize(decimation, samplesPerBlock);
+
+    forEachEngine([=](auto& engine) { engine.prepare(tailSampleRate, tailBlockSize, numOutputChannels); });
+    fadeBuffer.setSize(numOutputChannels, tailBlockSize);
+    switchFadeSamples = std::max(1, static_cast<int>(std::round(kSwitchFadeSeconds * tailSampleRate)));
+
+    // The convolution stands in for the engines, so it runs at their rate too
+    preparedChannels = numOutputChannels;
+    snapshot.prepare(tailSampleRate, tailBlockSize, numOutputChannels);
+    snapshotInput.assign(static_cast<size_t>(tailBlockSize), 0.0f);
+    snapshotShare = 0.0f;
+
+    // Every engine starts out clear, so a pending change needs no crossfade
+    activeSlot = requestedSlot;
+    fadeSlot = activeSlot;
+    ringingSlots = 0;
+}
+
+template <typename SampleType>
+void ReverbSection<SampleType>::setQuality(int newQuality)
+{
+    settings.quality = juce::jlimit(0, ReverbTiers::numQualities - 1, newQuality);
+    updateRequestedSlot();
+}
+
+template <typename SampleType>
+void ReverbSection<SampleType>::setAlgorithm(int newAlgorithm)
+{
+    settings.algorithm = juce::jlimit(0, numAlgorithms - 1, newAlgorithm);
+    updateRequestedSlot();
+}
+
+template <typename SampleType>
+int ReverbSection<SampleType>::slotFor(const ReverbSnapshotSettings& engineSettings) noexcept
+{
+    if (engineSettings.algorithm == fdn)
+        return engineSettings.quality == ReverbTiers::eco ? fdnSmallSlot : fdnLargeSlot;
+
+    return engineSettings.quality == ReverbTiers::eco   ? ecoSlot
+         : engineSettings.quality == ReverbTiers::ultra ? ultraSlot
+                                                        : standardSlot;
+}
+
+template <typename SampleType>
+void ReverbSection<SampleType>::updateRequestedSlot()
+{
+    const int previousSlot = requestedSlot;
+    requestedSlot = slotFor(settings);
+
+    // An engine that was not live has missed every setter since it last was
+    if (requestedSlot != previousSlot && requestedSlot != activeSlot && requestedSlot != fadeSlot)
+        bringUpToDate(requestedSlot);
+}
+
+template <typename SampleType>
+template <typename Engine>
+void ReverbSection<SampleType>::applySettingsTo(Engine& engine, const ReverbSnapshotSettings& engineSettings,
+                                                float preDelayMs, float rateHz)
+{
+    engine.setGravity(engineSettings.gravity);
+    engine.setSize(engineSettings.size);
+    engine.setPreDelay(preDelayMs);
+    engine.setFeedback(engineSettings.feedback);
+    engine.setModulation(engineSettings.modDepth, rateHz);
+    engine.setLoEQ(engineSettings.loEQ);
+    engine.setHiEQ(engineSettings.hiEQ);
+    engine.setResonance(engineSettings.resonance);
+    engine.setFreeze(engineSettings.freeze);
+}
+
+template <typename SampleType>
+void ReverbSection<SampleType>::bringUpToDate(int slot)
+{
+    withEngine(slot, [this](auto& engine)
+    {
+        applySettingsTo(engine, settings, compensatedPreDelay(settings.preDelay), modRateHz);
+        engine.setKillDry(killDry);
+
+        // Its filters may still hold interpolated (morph) coefficients, so rebuild them all
+        engine.invalidateCoefficients();
+        engine.updateCoefficients();
+    });
+}
+
+template <typename SampleType>
+float ReverbSection<SampleType>::compensatedPreDelay(float ms) const noexcept
+{
+    // The resampler delays the tail a little; take that off the pre-delay where there is any
+    return std::max(0.0f, ms - resamplerLatencyMs);
+}
+
+template <typename SampleType>
+void ReverbSection<SampleType>::setGravity(float gravity)
+{
+    settings.gravity = gravity;
+    forEachLiveEngine([=](auto& engine) { engine.setGravity(gravity); });
+}
+
+template <typename SampleType>
+void ReverbSection<SampleType>::setSize(float size)
+{
+    settings.size = size;
+    forEachLiveEngine([=](auto& engine) { engine.setSize(size); });
+}
+
+template <typename SampleType>
+void ReverbSection<SampleType>::setPreDelay(float ms)
+{
+    settings.preDelay = ms;
+    const float compensated = compensatedPreDelay(ms);
+    forEachLiveEngine([=](auto& engine) { engine.setPreDelay(compensated); });
+}
+
+template <typename SampleType>
+void ReverbSection<SampleType>::setFeedback(float percent)
+{
+    settings.feedback = percent;
+    forEachLiveEngine([=](auto& engine) { engine.setFeedback(percent); });
+}
+
+template <typename SampleType>
+void ReverbSection<SampleType>::setModulation(float depthPercent, float rateHz)
+{
+    settings.modDepth = depthPercent;
+    modRateHz = rateHz;
+    forEachLiveEngine([=](auto& engine) { engine.setModulation(depthPercent, rateHz); });
+}
+
+template <typename SampleType>
+void ReverbSection<SampleType>::setLoEQ(float dB)
+{
+    settings.loEQ = dB;
+    forEachLiveEngine([=](auto& engine) { engine.setLoEQ(dB); });
+}
+
+template <typename SampleType>
+void ReverbSection<SampleType>::setHiEQ(float dB)
+{
+    settings.hiEQ = dB;
+    forEachLiveEngine([=](auto& engine) { engine.setHiEQ(dB); });
+}
+
+template <typename SampleType>
+void ReverbSection<SampleType>::setResonance(float percent)
+{
+    settings.resonance = percent;
+    forEachLiveEngine([=](auto& engine) { engine.setResonance(percent); });
+}
+
+template <typename SampleType>
+void ReverbSection<SampleType>::setFreeze(bool frozen)
+{
+    settings.freeze = frozen;
+    forEachLiveEngine([=](auto& engine) { engine.setFreeze(frozen); });
+}
+
+template <typename SampleType>
+void ReverbSection<SampleType>::setKillDry(bool kill)
+{
+    killDry = kill;
+    forEachLiveEngine([=](auto& engine) { engine.setKillDry(kill); });
+}
+
+template <typename SampleType>
+void ReverbSection<SampleType>::updateCoefficients()
+{
+    forEachLiveEngine([](auto& engine) { engine.updateCoefficients(); });
+}
+
+template <typename SampleType>
+bool ReverbSection<SampleType>::installCoefficients(const ReverbCoefficientSet& set)
+{
+    // The live engines hold the same settings, so they all accept or all refuse
+    bool accepted = true;
+    forEachLiveEngine([&](auto& engine) { accepted = engine.installCoefficients(set) && accepted; });
+    return accepted;
+}
+
+template <typename SampleType>
+void ReverbSection<SampleType>::interpolateCoefficients(const ReverbCoefficientSet& a,
+                                                        const ReverbCoefficientSet& b, float t)
+{
+    forEachLiveEngine([&](auto& engine) { engine.interpolateCoefficients(a, b, t); });
+}
+
+template <typename SampleType>
+void ReverbSection<SampleType>::invalidateCoefficients()
+{
+    forEachLiveEngine([](auto& engine) { engine.invalidateCoefficients(); });
+}
+
+template <typename SampleType>
+void ReverbSection<SampleType>::process(juce::AudioBuffer<SampleType>& buffer)
+{
+    if (snapshotEnabled || snapshotShare > 0.0f || !snapshot.isIdle())
+    {
+        resampler.process(buffer, [this](juce::AudioBuffer<SampleType>& tail) { processWithSnapshot(tail); });
+        return;
+    }
+
+    resampler.process(buffer, [this](juce::AudioBuffer<SampleType>& tail) { processEngines(tail); });
+}
+
+template <typename SampleType>
+void ReverbSection<SampleType>::processWithSnapshot(juce::AudioBuffer<SampleType>& buffer)
+{
+    const int numChannels = buffer.getNumChannels();
+    const int numSamples = buffer.getNumSamples();
+    jassert(numSamples <= static_cast<int>(snapshotInput.size()));
+
+    const bool inputSilent = SilenceDetector::isSilent(buffer);
+
+    snapshot.receive();
+    const float startShare = snapshotShare;
+    snapshotShare = snapshotEnabled && settings.isLinear() && snapshot.matches(settings) ? 1.0f : 0.0f;
+
+    // Mono, soft-clipped input for the convolution, as the engines form it
+    if (startShare > 0.0f || snapshotShare > 0.0f)
+    {
+        const float channelScale = 1.0f / static_cast<float>(numChannels);
+        const float shareStep = (snapshotShare - startShare) / static_cast<float>(numSamples);
+
+        for (int n = 0; n < numSamples; ++n)
+        {
+            SampleType mono = buffer.getSample(0, n);
+            for (int ch = 1; ch < numChannels; ++ch)
+                mono += buffer.getSample(ch, n);
+
+            const float share = startShare + shareStep * static_cast<float>(n + 1);
+            snapshotInput[static_cast<size_t>(n)] = share * FastMath::tanh(static_cast<float>(mono) * channelScale);
+        }
+    }
+    else
+    {
+        // Ringing out
+        std::fill(snapshotInput.begin(), snapshotInput.begin() + numSamples, 0.0f);
+    }
+
+    // The engines get the rest of the input. Once the convolution takes all of it they
+    // only ring out, and once asleep they are not run at all.
+    if (startShare == 1.0f && snapshotShare == 1.0f)
+    {
+        buffer.clear();
+
+        if (!enginesSleeping())
+            processEngines(buffer);
+    }
+    else
+    {
+        if (startShare > 0.0f || snapshotShare > 0.0f)
+            for (int ch = 0; ch < numChannels; ++ch)
+                buffer.applyGainRamp(ch, 0, numSamples, SampleType(1.0f - startShare), SampleType(1.0f - snapshotShare));
+
+        processEngines(buffer);
+    }
+
+    const bool convolutionSilent = inputSilent || (startShare == 0.0f && snapshotShare == 0.0f);
+    snapshot.process(snapshotInput.data(), convolutionSilent, buffer.getArrayOfWritePointers(), numChannels, numSamples);
+}
+
+template <typename SampleType>
+bool ReverbSection<SampleType>::captureSnapshot(const ReverbSnapshotSettings& newSettings)
+{
+    if (!newSettings.isLinear())
+        return false;
+
+    switch (slotFor(newSettings))
+    {
+        case ecoSlot:      return renderSnapshot<ReverbEngine<double, ReverbTiers::Eco>>(newSettings);
+        case ultraSlot:    return renderSnapshot<ReverbEngine<double, ReverbTiers::Ultra>>(newSettings);
+        case fdnSmallSlot: return renderSnapshot<FdnReverbEngine<double, 8>>(newSettings);
+        case fdnLargeSlot: return renderSnapshot<FdnReverbEngine<double, 16>>(newSettings);
+        default:           return renderSnapshot<ReverbEngine<double, ReverbTiers::Standard>>(newSettings);
+    }
+}
+
+template <typename SampleType>
+template <typename Engine>
+bool ReverbSection<SampleType>::renderSnapshot(const ReverbSnapshotSettings& newSettings)
+{
+    auto shouldStop = []
+    {
+        auto* job = juce::ThreadPoolJob::getCurrentThreadPoolJob();
+        return job != nullptr && job->shouldExit();
+    };
+
+    // The selected engine in double precision at this section's tail rate, as the
+    // convolution runs, and kept awake so the tail is rendered all the way down rather
+    // than to the sleep threshold of an impulse this small
+    const int partitionSize = snapshot.getPartitionSize();
+
+    auto engine = std::make_unique<Engine>();
+    engine->prepare(tailSampleRate, partitionSize, preparedChannels);
+    engine->setSleepEnabled(false);
+    applySettingsTo(*engine, newSettings, compensatedPreDelay(newSettings.preDelay), 1.0f);
+    engine->updateCoefficients();
+
+    // The tail estimate runs down to the sleep threshold for a full-scale input
+    const int maxLength = snapshot.getMaxImpulseSamples();
+    const int estimatedLength = static_cast<int>(std::min(static_cast<double>(maxLength),
+                                                          std::ceil(engine->getTailLengthSeconds() * tailSampleRate)));
+
+    const double threshold = juce::Decibels::decibelsToGain(static_cast<double>(SilenceDetector::kThresholdDb))
+                           * kCaptureImpulse;
+
+    // Rendered and transformed one partition at a time
+    typename ReverbSnapshot<SampleType>::Builder builder(snapshot, newSettings);
+    juce::AudioBuffer<double> block(preparedChannels, partitionSize);
+    int length = 0;
+
+    for (int start = 0; start < estimatedLength; start += partitionSize)
+    {
+        if (shouldStop())
+            return false;
+
+        juce::AudioBuffer<double> partition(block.getArrayOfWritePointers(), preparedChannels,
+                                            std::min(partitionSize, estimatedLength - start));
+        partition.clear();
+        if (start == 0)
+            for (int ch = 0; ch < preparedChannels; ++ch)
+                partition.setSample(ch, 0, kCaptureImpulse);
+
+        engine->process(partition);
+
+        // Up to the last sample above the sleep threshold (the estimate is an upper bound)
+        for (int i = partition.getNumSamples() - 1; i >= 0; --i)
+        {
+            if (partition.getMagnitude(i, 1) >= threshold)
+            {
+                length = start + i + 1;
+                break;
+            }
+        }
+
+        builder.addPartition(partition.getArrayOfReadPointers(), partition.getNumSamples(), 1.0 / kCaptureImpulse);
+    }
+
+    // A tail still above the threshold at the end does not fit in a snapshot
+    if (length == 0 || (length == estimatedLength && estimatedLength == maxLength))
+        return false;
+
+    builder.trim(length);
+    return snapshot.post(builder);
+}
+
+template <typename SampleType>
+void ReverbSection<SampleType>::processEngines(juce::AudioBuffer<SampleType>& buffer)
+{
+    // A new switch starts once the previous fade has completed. An engine still ringing
+    // out simply takes its input back.
+    if (fadeSlot == activeSlot && requestedSlot != activeSlot)
+    {
+        fadeSlot = requestedSlot;
+        fadePosition = 0;
+        ringingSlots &= ~slotBit(fadeSlot);
+    }
+
+    if (fadeSlot != activeSlot)
+        switchEngine(buffer);
+    else
+        withEngine(activeSlot, [&buffer](auto& engine) { engine.process(buffer); });
+
+    ringOut(buffer);
+}
+
+template <typename SampleType>
+void ReverbSection<SampleType>::switchEngine(juce::AudioBuffer<SampleType>& buffer)
+{
+    const int numChannels = buffer.getNumChannels();
+    const int numSamples = buffer.getNumSamples();
+    jassert(numChannels <= fadeBuffer.getNumChannels() && numSamples <= fadeBuffer.getNumSamples());
+
+    // Non-owning view onto the preallocated copy (no heap use below 32 channels)
+    juce::AudioBuffer<SampleType> incoming(fadeBuffer.getArrayOfWritePointers(), numChannels, numSamples);
+
+    // The input is split between the engines rather than their outputs faded, so both
+    // keep what they already hold. Past the end of the fade the outgoing one gets nothing.
+    const int fadeSamples = std::min(numSamples, switchFadeSamples - fadePosition);
+    const SampleType gainStep = SampleType(1) / static_cast<SampleType>(switchFadeSamples);
+
+    for (int ch = 0; ch < numChannels; ++ch)
+    {
+        SampleType* outgoingInput = buffer.getWritePointer(ch);
+        SampleType* incomingInput = incoming.getWritePointer(ch);
+
+        for (int n = 0; n < numSamples; ++n)
+        {
+            const SampleType gain = n < fadeSamples ? static_cast<SampleType>(fadePosition + n + 1) * gainStep
+                                                    : SampleType(1);
+            incomingInput[n] = outgoingInput[n] * gain;
+            outgoingInput[n] *= SampleType(1) - gain;
+        }
+    }
+
+    withEngine(activeSlot, [&buffer](auto& engine) { engine.process(buffer); });
+    withEngine(fadeSlot, [&incoming](auto& engine) { engine.process(incoming); });
+
+    for (int ch = 0; ch < numChannels; ++ch)
+        buffer.addFrom(ch, 0, incoming, ch, 0, numSamples);
+
+    fadePosition += fadeSamples;
+    if (fadePosition >= switchFadeSamples)
+    {
+        ringingSlots |= slotBit(activeSlot);
+        activeSlot = fadeSlot;
+    }
+}
+
+template <typename SampleType>
+void ReverbSection<SampleType>::ringOut(juce::AudioBuffer<SampleType>& buffer)
+{
+    if (ringingSlots == 0)
+        return;
+
+    const int numChannels = buffer.getNumChannels();
+    const int numSamples = buffer.getNumSamples();
+    juce::AudioBuffer<SampleType> tail(fadeBuffer.getArrayOfWritePointers(), numChannels, numSamples);
+
+    for (int slot = 0; slot < numSlots; ++slot)
+    {
+        if ((ringingSlots & slotBit(slot)) == 0)
+            continue;
+
+        // A frozen tail would never go to sleep, so only an engine waiting to be faded
+        // back in may hold on to it. Once asleep an engine adds nothing more; whatever it
+        // has left to clear is cleared ahead of the reads when it next wakes.
+        const bool release = slot != requestedSlot;
+        tail.clear();
+        const bool asleep = withEngine(slot, [&tail, release](auto& engine)
+        {
+            if (release)
+                engine.setFreeze(false);
+
+            engine.process(tail);
+            return engine.isSleeping();
+        });
+
+        for (int ch = 0; ch < numChannels; ++ch)
+            buffer.addFrom(ch, 0, tail, ch, 0, numSamples);
+
+        if (asleep)
+            ringingSlots &= ~slotBit(slot);
+    }
+}
+
+template <typename SampleType>
+bool ReverbSection<SampleType>::enginesSleeping() const noexcept
+{
+    return fadeSlot == activeSlot && ringingSlots == 0
+        && withEngine(activeSlot, [](const auto& engine) { return engine.isSleeping(); });
+}
+
+template <typename SampleType>
+void ReverbSection<SampleType>::reset()
+{
+    forEachEngine([](auto& engine) { engine.reset(); });
+    resampler.reset();
+    snapshot.reset();
+    snapshotShare = 0.0f;
+    activeSlot = requestedSlot;
+    fadeSlot = activeSlot;
+    ringingSlots = 0;
+}
+
+template <typename SampleType>
+bool ReverbSection<SampleType>::isSleeping() const noexcept
+{
+    return enginesSleeping() && snapshot.isIdle();
+}
+
+template <typename SampleType>
+float ReverbSection<SampleType>::getFeedbackSample(int channel) const noexcept
+{
+    return withEngine(activeSlot, [channel](const auto& engine) { return engine.getFeedbackSample(channel); });
+}
+
+template <typename SampleType>
+double ReverbSection<SampleType>::getTailLengthSeconds() const
+{
+    return withEngine(activeSlot, [](const auto& engine) { return engine.getTailLengthSeconds(); });
+}
+
+template class ReverbSection<float>;
+template class ReverbSection<double>;
@@ -0,0 +1,227 @@
+#pragma once
+#include <JuceHeader.h>
+#include "ReverbEngine.h"
+#include "FdnReverbEngine.h"
+#include "HalfBandResampler.h"
+#include "ReverbSnapshot.h"
+
+// The reverb as the processor drives it: one ReverbEngine per quality tier (ReverbTiers)
+// plus an 8-line and a 16-line FdnReverbEngine for the FDN algorithm (8 lines at Eco,
+// 16 otherwise), all prepared up front so a tier or algorithm change never allocates.
+// Only the live engines — the active one and, until a switch completes, the requested one —
+// receive setters and coefficient updates, and only they process. The section keeps the
+// settings itself and brings an engine up to date from them when it is requested. A change
+// crossfades the input from the old engine to the new one over kSwitchFadeSeconds of
+// samples, however the host splits its blocks. The old engine then rings out with its
+// input muted until it goes to sleep, so its tail is never cut and it is never reset on
+// the audio thread. A change requested mid-fade starts once the fade completes. While
+// tails overlap after quick successive changes, up to every engine may be running.
+//
+// At high host rates the engines can run decimated (see TailRate): the input goes through
+// a HalfBandResampler and the engines are prepared at the lower rate, so their delay
+// lengths, which follow the prepared rate, come out the same in seconds.
+//
+// With snapshots enabled, settings that leave the reverb linear can be played back as an
+// impulse response instead (see captureSnapshot() and ReverbSnapshot). While a snapshot
+// rendered with the current settings is loaded, the input crossfades over one block from
+// the engines to the convolution, and back as soon as any setting moves; each side rings
+// out what it already holds, and the idle engine goes to sleep. The convolution runs
+// where the engines do, at the tail rate inside the resampler: decimation makes the
+// reverb as a whole depend on the input phase, which no single impulse response at the
+// host rate could follow, but the engine behind it is time-invariant.
+// Templated on the sample type; instantiated for float and double in ReverbSection.cpp.
+template <typename SampleType>
+class ReverbSection
+{
+public:
+    ReverbSection() = default;
+
+    static constexpr int kMaxOutputChannels = ReverbTiers::kMaxOutputChannels;
+
+    // Length of the input crossfade between engines on a tier or algorithm change
+    static constexpr double kSwitchFadeSeconds = 0.03;
+
+    enum Algorithm
+    {
+        allpass,        // Allpass cascade with global feedback (ReverbEngine)
+        fdn,            // Feedback delay network (FdnReverbEngine)
+        numAlgorithms
+    };
+
+    enum TailRate
+    {
+        fullRate,
+        halfRate,
+        quarterRate,
+        numTailRates
+    };
+
+    // Lowest rate the engines may be decimated to: keeps the feedback damping (10 kHz)
+    // and the resampler's transition band clear of the audio band
+    static constexpr double kMinTailSampleRate = 44100.0;
+
+    // Decimation factor (1, 2 or 4) for `tailRate` at `sampleRate`, reduced as far as
+    // needed to stay at or above kMinTailSampleRate
+    static int decimationFor(double sampleRate, int tailRate);
+
+    // decimation is 1, 2 or 4 (see decimationFor()). Allocates.
+    void prepare(double sampleRate, int samplesPerBlock, int numOutputChannels, int decimation = 1);
+    double getTailSampleRate() const noexcept { return tailSampleRate; }
+    void setQuality(int quality);      // ReverbTiers::Quality
+    void setAlgorithm(int algorithm);  // Algorithm
+
+    void setGravity(float gravity);
+    void setSize(float size);
+    void setPreDelay(float ms);
+    void setFeedback(float percent);
+    void setModulation(float depthPercent, float rateHz);
+    void setLoEQ(float dB);
+    void setHiEQ(float dB);
+    void setResonance(float percent);
+    void setFreeze(bool frozen);
+    void setKillDry(bool kill);
+
+    // Plays a loaded impulse response snapshot whenever it matches the current settings
+    void setSnapshotEnabled(bool enabled)              { snapshotEnabled = enabled; }
+
+    // Background thread (never alongside prepare()): renders the impulse response of one
+    // private engine of the kind `settings` select, at this section's tail rate, and posts
+    // it for playback, transforming it partition by partition as it goes. False if the
+    // settings are not linear, the tail is longer than a snapshot holds, or the ThreadPool
+    // job running it was asked to stop.
+    bool captureSnapshot(const ReverbSnapshotSettings& settings);
+
+    // Coefficient handling as in ReverbEngine, applied to the live engines
+    void updateCoefficients();
+    bool installCoefficients(const ReverbCoefficientSet& set);
+    void interpolateCoefficients(const ReverbCoefficientSet& a, const ReverbCoefficientSet& b, float t);
+    void invalidateCoefficients();
+
+    void process(juce::AudioBuffer<SampleType>& buffer);
+    void reset();
+
+    // These report on the engine that is processing
+    bool isSleeping() const noexcept;
+    float getFeedbackSample(int channel) const noexcept;
+    double getTailLengthSeconds() const;
+
+private:
+    // One slot per engine
+    enum Slot
+    {
+        ecoSlot,
+        standardSlot,
+        ultraSlot,
+        fdnSmallSlot,
+        fdnLargeSlot,
+        numSlots
+    };
+
+    static constexpr unsigned int slotBit(int slot) noexcept { return 1u << slot; }
+
+    static int slotFor(const ReverbSnapshotSettings& engineSettings) noexcept;
+    void updateRequestedSlot();
+
+    // Every engine setter the snapshot settings cover
+    template <typename Engine>
+    static void applySettingsTo(Engine& engine, const ReverbSnapshotSettings& engineSettings,
+                                float preDelayMs, float rateHz);
+
+    // Applies the stored settings to an engine that was not live, and its coefficients
+    void bringUpToDate(int slot);
+    float compensatedPreDelay(float ms) const noexcept;
+
+    // captureSnapshot() for one engine type
+    template <typename Engine>
+    bool renderSnapshot(const ReverbSnapshotSettings& newSettings);
+
+    template <typename Function>
+    void forEachEngine(Function&& function)
+    {
+        function(eco);
+        function(standard);
+        function(ultra);
+        function(fdnSmall);
+        function(fdnLarge);
+    }
+
+    // The active engine, the one being faded in and the requested one
+    template <typename Function>
+    void forEachLiveEngine(Function&& function)
+    {
+        withEngine(activeSlot, function);
+        if (fadeSlot != activeSlot)
+            withEngine(fadeSlot, function);
+        if (requestedSlot != activeSlot && requestedSlot != fadeSlot)
+            withEngine(requestedSlot, function);
+    }
+
+    template <typename Function>
+    decltype(auto) withEngine(int slot, Function&& function)
+    {
+        switch (slot)
+        {
+            case ecoSlot:      return function(eco);
+            case ultraSlot:    return function(ultra);
+            case fdnSmallSlot: return function(fdnSmall);
+            case fdnLargeSlot: return function(fdnLarge);
+            default:           return function(standard);
+        }
+    }
+
+    template <typename Function>
+    decltype(auto) withEngine(int slot, Function&& function) const
+    {
+        switch (slot)
+        {
+            case ecoSlot:      return function(eco);
+            case ultraSlot:    return function(ultra);
+            case fdnSmallSlot: return function(fdnSmall);
+            case fdnLargeSlot: return function(fdnLarge);
+            default:           return function(standard);
+        }
+    }
+
+    void processEngines(juce::AudioBuffer<SampleType>& buffer);
+
+    // Splits the (tail-rate) input between the engines and the snapshot convolution
+    void processWithSnapshot(juce::AudioBuffer<SampleType>& buffer);
+
+    // Runs both engines on the block, moving the input from the active one to fadeSlot
+    void switchEngine(juce::AudioBuffer<SampleType>& buffer);
+
+    // Adds the tails of the ringing engines, run on silence, until each goes to sleep
+    void ringOut(juce::AudioBuffer<SampleType>& buffer);
+
+    // The active engine is asleep and no other engine is fading in or ringing out
+    bool enginesSleeping() const noexcept;
+
+    ReverbEngine<SampleType, ReverbTiers::Eco> eco;
+    ReverbEngine<SampleType, ReverbTiers::Standard> standard;
+    ReverbEngine<SampleType, ReverbTiers::Ultra> ultra;
+    FdnReverbEngine<SampleType, 8> fdnSmall;
+    FdnReverbEngine<SampleType, 16> fdnLarge;
+
+    ReverbSnapshotSettings settings;     // As last set
+    float modRateHz = 1.0f;
+    bool killDry = false;
+    int activeSlot = standardSlot;
+    int requestedSlot = standardSlot;
+    int fadeSlot = standardSlot;         // Engine being faded in; activeSlot when no fade runs
+    int fadePosition = 0;                // Samples of the fade done
+    int switchFadeSamples = 1;           // kSwitchFadeSeconds at the tail rate
+    unsigned int ringingSlots = 0;       // slotBit() per engine ringing out with muted input
+
+    HalfBandResampler<SampleType> resampler;
+    double tailSampleRate = 44100.0;
+    float resamplerLatencyMs = 0.0f;
+
+    ReverbSnapshot<SampleType> snapshot;
+    bool snapshotEnabled = false;
+    float snapshotShare = 0.0f;          // Part of the input the convolution takes, 0..1
+    std::vector<float> snapshotInput;    // Mono convolution input, sized in prepare()
+    int preparedChannels = 0;
+
+    // Input for the incoming engine during a switch, and for the ringing engines; sized in prepare()
+    juce::AudioBuffer<SampleType> fadeBuffer;
+};
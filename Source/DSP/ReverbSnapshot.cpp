@@ -0,0 +1,312 @@
+#include "ReverbSnapshot.h"
+
+namespace
+{
+    // out += a * b over interleaved complex bins
+    void multiplyAdd(const float* a, const float* b, float* out, int numFloats) noexcept
+    {
+        for (int k = 0; k < numFloats; k += 2)
+        {
+            const float ar = a[k], ai = a[k + 1];
+            const float br = b[k], bi = b[k + 1];
+            out[k]     += ar * br - ai * bi;
+            out[k + 1] += ar * bi + ai * br;
+        }
+    }
+
+    // The inverse real transform reads the full spectrum: mirror bins 1..N/2-1 as conjugates
+    void fillNegativeFrequencies(float* spectrum, int fftSize) noexcept
+    {
+        for (int i = 1; i < fftSize / 2; ++i)
+        {
+            spectrum[2 * (fftSize - i)]     =  spectrum[2 * i];
+            spectrum[2 * (fftSize - i) + 1] = -spectrum[2 * i + 1];
+        }
+    }
+
+    int log2Of(int powerOfTwo) noexcept
+    {
+        int order = 0;
+        while ((1 << order) < powerOfTwo)
+            ++order;
+        return order;
+    }
+}
+
+template <typename SampleType>
+void ReverbSnapshot<SampleType>::prepare(double sampleRate, int maxBlockSize, int channels)
+{
+    numChannels = channels;
+    partitionSize = juce::jlimit(kMinPartitionSize, kMaxPartitionSize, juce::nextPowerOfTwo(maxBlockSize));
+    fftSize = 2 * partitionSize;
+    fftOrder = log2Of(fftSize);
+    spectrumSize = fftSize + 2;
+    maxPartitions = static_cast<int>(std::ceil(kMaxSeconds * sampleRate / partitionSize));
+
+    fft = std::make_unique<juce::dsp::FFT>(fftOrder);
+
+    // Responses are transformed for one partition size — anything loaded is stale now
+    current = nullptr;
+    handoff.store(packState(-1, -1));
+    for (auto& kernel : kernels)
+        kernel = Kernel();
+
+    reset();
+}
+
+template <typename SampleType>
+ReverbSnapshot<SampleType>::Builder::Builder(const ReverbSnapshot& owner, const ReverbSnapshotSettings& settings)
+    : partitionSize(owner.partitionSize),
+      fftSize(owner.fftSize),
+      spectrumSize(owner.spectrumSize),
+      maxPartitions(owner.maxPartitions),
+      numChannels(owner.numChannels),
+      transform(owner.fftOrder),
+      work(static_cast<size_t>(2 * owner.fftSize)),
+      kernel(std::make_unique<Kernel>())
+{
+    kernel->settings = settings;
+}
+
+template <typename SampleType>
+ReverbSnapshot<SampleType>::Builder::~Builder() = default;
+
+template <typename SampleType>
+bool ReverbSnapshot<SampleType>::Builder::addPartition(const double* const* channels, int numSamples, double gain)
+{
+    jassert(numSamples <= partitionSize);
+    if (kernel->numPartitions == maxPartitions)
+        return false;
+
+    for (int ch = 0; ch < numChannels; ++ch)
+    {
+        std::fill(work.begin(), work.end(), 0.0f);
+        for (int i = 0; i < numSamples; ++i)
+            work[static_cast<size_t>(i)] = static_cast<float>(channels[ch][i] * gain);
+
+        transform.performRealOnlyForwardTransform(work.data(), true);
+        kernel->spectra.insert(kernel->spectra.end(), work.begin(), work.begin() + spectrumSize);
+    }
+
+    ++kernel->numPartitions;
+    kernel->length += numSamples;
+    return true;
+}
+
+template <typename SampleType>
+void ReverbSnapshot<SampleType>::Builder::trim(int length)
+{
+    if (length >= kernel->length)
+        return;
+
+    kernel->length = std::max(0, length);
+    kernel->numPartitions = (kernel->length + partitionSize - 1) / partitionSize;
+    kernel->spectra.resize(static_cast<size_t>(kernel->numPartitions * numChannels * spectrumSize));
+    kernel->spectra.shrink_to_fit();
+}
+
+template <typename SampleType>
+int ReverbSnapshot<SampleType>::claimKernel() noexcept
+{
+    for (;;)
+    {
+        int state = handoff.load(std::memory_order_acquire);
+        const int ready = readyOf(state);
+        const int inUse = inUseOf(state);
+
+        for (int k = 0; k < 2; ++k)
+            if (k != ready && k != inUse)
+                return k;
+
+        // One slot plays, the other is posted but not picked up yet: take it back
+        if (handoff.compare_exchange_weak(state, packState(-1, inUse), std::memory_order_acq_rel))
+            return ready;
+    }
+}
+
+template <typename SampleType>
+bool ReverbSnapshot<SampleType>::post(Builder& builder)
+{
+    jassert(builder.partitionSize == partitionSize && builder.numChannels == numChannels);
+    if (builder.kernel->numPartitions == 0)
+        return false;
+
+    const int index = claimKernel();
+    Kernel& kernel = kernels[index];
+    kernel = std::move(*builder.kernel);
+
+    const auto channels = static_cast<size_t>(numChannels);
+    kernel.history.assign(static_cast<size_t>(kernel.numPartitions * spectrumSize), 0.0f);
+    kernel.inputBlock.assign(static_cast<size_t>(fftSize), 0.0f);
+    kernel.scratch.assign(static_cast<size_t>(2 * fftSize), 0.0f);
+    kernel.tailSpectra.assign(channels * static_cast<size_t>(spectrumSize), 0.0f);
+    kernel.pendingTail.assign(channels * static_cast<size_t>(spectrumSize), 0.0f);
+    kernel.overlap.assign(channels * static_cast<size_t>(partitionSize), 0.0f);
+
+    int state = handoff.load(std::memory_order_acquire);
+    while (! handoff.compare_exchange_weak(state, packState(index, inUseOf(state)), std::memory_order_acq_rel)) {}
+
+    return true;
+}
+
+template <typename SampleType>
+void ReverbSnapshot<SampleType>::receive() noexcept
+{
+    if (! isIdle())
+        return;
+
+    int state = handoff.load(std::memory_order_acquire);
+    const int ready = readyOf(state);
+    if (ready < 0)
+        return;
+
+    // If the background posts again in between, the next block picks that one up
+    if (! handoff.compare_exchange_strong(state, packState(-1, ready), std::memory_order_acq_rel))
+        return;
+
+    // A posted response comes with clear state, so only the partition position starts over
+    current = &kernels[ready];
+    inputPos = 0;
+    currentSegment = 0;
+    deferredTerms = 0;
+}
+
+template <typename SampleType>
+void ReverbSnapshot<SampleType>::process(const float* input, bool inputSilent, SampleType* const* outputs,
+                                         int channels, int numSamples) noexcept
+{
+    if (current == nullptr)
+        return;
+
+    if (inputSilent)
+    {
+        if (isIdle())
+            return;
+
+        silentSamples += numSamples;
+    }
+    else
+    {
+        silentSamples = 0;
+    }
+
+    jassert(channels <= numChannels);
+    channels = std::min(channels, numChannels);
+
+    for (int done = 0; done < numSamples;)
+    {
+        const int count = std::min(numSamples - done, partitionSize - inputPos);
+        processPartial(input + done, outputs, done, channels, count);
+        done += count;
+    }
+}
+
+template <typename SampleType>
+void ReverbSnapshot<SampleType>::processPartial(const float* input, SampleType* const* outputs, int offset,
+                                                int channels, int numSamples) noexcept
+{
+    Kernel& k = *current;
+    const int numPartitions = k.numPartitions;
+    const bool partitionStart = inputPos == 0;
+    const auto partitionStride = static_cast<size_t>(numChannels * spectrumSize);
+
+    // The next partition's terms from partition 2 on only use inputs complete by now, so
+    // they are accumulated a share at a time, in proportion to the samples played so far
+    const int numDeferred = std::max(0, numPartitions - 2);
+    const int deferredTarget = static_cast<int>(static_cast<juce::int64>(numDeferred) * (inputPos + numSamples) / partitionSize);
+
+    // Spectrum of the partition so far
+    std::copy(input, input + numSamples, k.inputBlock.begin() + inputPos);
+    std::copy(k.inputBlock.begin(), k.inputBlock.end(), k.scratch.begin());
+    std::fill(k.scratch.begin() + fftSize, k.scratch.end(), 0.0f);
+    fft->performRealOnlyForwardTransform(k.scratch.data(), true);
+
+    float* segment = k.history.data() + static_cast<size_t>(currentSegment * spectrumSize);
+    std::copy(k.scratch.begin(), k.scratch.begin() + spectrumSize, segment);
+
+    for (int ch = 0; ch < channels; ++ch)
+    {
+        const float* kernel = k.spectra.data() + static_cast<size_t>(ch * spectrumSize);
+        float* tail = k.tailSpectra.data() + static_cast<size_t>(ch * spectrumSize);
+        float* pending = k.pendingTail.data() + static_cast<size_t>(ch * spectrumSize);
+
+        // Older partitions only change once per partition: segment currentSegment + p holds
+        // the input from p partitions ago. All but the one just completed were summed into
+        // pendingTail while it played.
+        if (partitionStart)
+        {
+            std::copy(pending, pending + spectrumSize, tail);
+            std::fill(pending, pending + spectrumSize, 0.0f);
+
+            if (numPartitions > 1)
+            {
+                const int index = currentSegment + 1 < numPartitions ? currentSegment + 1 : 0;
+                multiplyAdd(k.history.data() + static_cast<size_t>(index * spectrumSize),
+                            kernel + partitionStride, tail, spectrumSize);
+            }
+        }
+
+        // Term t pairs kernel partition t + 2 with the input t + 1 partitions before this one
+        for (int term = deferredTerms; term < deferredTarget; ++term)
+        {
+            int index = currentSegment + term + 1;
+            if (index >= numPartitions)
+                index -= numPartitions;
+
+            multiplyAdd(k.history.data() + static_cast<size_t>(index * spectrumSize),
+                        kernel + static_cast<size_t>(term + 2) * partitionStride, pending, spectrumSize);
+        }
+
+        std::copy(tail, tail + spectrumSize, k.scratch.begin());
+        multiplyAdd(segment, kernel, k.scratch.data(), spectrumSize);
+        fillNegativeFrequencies(k.scratch.data(), fftSize);
+        fft->performRealOnlyInverseTransform(k.scratch.data());
+
+        const float* block = k.scratch.data() + inputPos;
+        float* tailOverlap = k.overlap.data() + static_cast<size_t>(ch * partitionSize);
+        SampleType* out = outputs[ch] + offset;
+        for (int i = 0; i < numSamples; ++i)
+            out[i] += static_cast<SampleType>(block[i] + tailOverlap[inputPos + i]);
+
+        if (inputPos + numSamples == partitionSize)
+            std::copy(k.scratch.begin() + partitionSize, k.scratch.begin() + fftSize, tailOverlap);
+    }
+
+    inputPos += numSamples;
+    deferredTerms = deferredTarget;
+
+    if (inputPos == partitionSize)
+    {
+        inputPos = 0;
+        deferredTerms = 0;
+        std::fill(k.inputBlock.begin(), k.inputBlock.begin() + partitionSize, 0.0f);
+        currentSegment = (currentSegment > 0 ? currentSegment : numPartitions) - 1;
+    }
+}
+
+template <typename SampleType>
+void ReverbSnapshot<SampleType>::Kernel::clearState()
+{
+    std::fill(history.begin(), history.end(), 0.0f);
+    std::fill(inputBlock.begin(), inputBlock.end(), 0.0f);
+    std::fill(tailSpectra.begin(), tailSpectra.end(), 0.0f);
+    std::fill(pendingTail.begin(), pendingTail.end(), 0.0f);
+    std::fill(overlap.begin(), overlap.end(), 0.0f);
+}
+
+template <typename SampleType>
+void ReverbSnapshot<SampleType>::reset()
+{
+    if (current != nullptr)
+        current->clearState();
+
+    inputPos = 0;
+    currentSegment = 0;
+    deferredTerms = 0;
+
+    // Nothing to ring out
+    silentSamples = std::numeric_limits<int>::max() / 2;
+}
+
+template class ReverbSnapshot<float>;
+template class ReverbSnapshot<double>;
@@ -0,0 +1,186 @@
+#pragma once
+#include <JuceHeader.h>
+#include <atomic>
+#include <memory>
+#include <vector>
+
+// The reverb settings an impulse response snapshot was rendered with. Values are the
+// plain parameter values as ReverbSection's setters receive them.
+struct ReverbSnapshotSettings
+{
+    float gravity    = 0.0f;
+    float size       = 0.0f;
+    float preDelay   = 0.0f;   // ms
+    float feedback   = 0.0f;   // percent
+    float modDepth   = 0.0f;   // percent
+    float loEQ       = 0.0f;
+    float hiEQ       = 0.0f;
+    float resonance  = 0.0f;
+    bool  freeze     = false;
+    int   quality    = 1;      // ReverbTiers::Quality
+    int   algorithm  = 0;      // ReverbSection::Algorithm
+
+    // Without modulation or Freeze the reverb is time-invariant. Its one nonlinearity is
+    // the tanh soft-clip, which sits inside ReverbEngine's feedback loop (after the
+    // feedback is injected) and on the FdnReverbEngine input; at reverb levels it stays
+    // close to linear, so an impulse response describes the reverb closely but not exactly.
+    bool isLinear() const noexcept { return modDepth == 0.0f && ! freeze; }
+
+    bool operator== (const ReverbSnapshotSettings& other) const noexcept
+    {
+        return gravity == other.gravity && size == other.size && preDelay == other.preDelay
+            && feedback == other.feedback && modDepth == other.modDepth
+            && loEQ == other.loEQ && hiEQ == other.hiEQ && resonance == other.resonance
+            && freeze == other.freeze && quality == other.quality && algorithm == other.algorithm;
+    }
+
+    bool operator!= (const ReverbSnapshotSettings& other) const noexcept { return ! (*this == other); }
+};
+
+// Plays a rendered reverb impulse response: uniformly partitioned FFT convolution of a mono
+// input with one response per output channel. Templated on the output sample type (the
+// convolution itself runs in float); instantiated for float and double in ReverbSnapshot.cpp.
+//
+// Zero latency: every call transforms the partition filled so far, multiplies it with the
+// first partition of the response and adds the older partitions. Those change once per
+// partition, and all of them but the partition just completed are known a whole partition
+// ahead, so they are accumulated across the calls of the partition before, in proportion
+// to its samples. A call therefore costs one forward and one inverse FFT plus, per
+// channel, about 2 + (partitions - 2) * numSamples / partitionSize spectrum multiply-adds,
+// instead of every partition's at the start of each one. The input spectrum is shared by
+// all output channels.
+//
+// Responses are transformed partition by partition on a background thread as they are
+// rendered (Builder), posted with post() and picked up by the audio thread with receive().
+// Each response carries its own input history and convolution state, sized to its length
+// and allocated when it is posted, so nothing beyond the FFT is held until then. Two
+// response slots are swapped through one atomic word, so the audio thread never waits or
+// allocates; a new response replaces the playing one only once that one has rung out
+// (see isIdle()).
+template <typename SampleType>
+class ReverbSnapshot
+{
+    struct Kernel;
+
+public:
+    ReverbSnapshot() = default;
+
+    // Longest response a snapshot holds
+    static constexpr double kMaxSeconds = 10.0;
+
+    // Partition size follows the host block size within these limits
+    static constexpr int kMinPartitionSize = 512;
+    static constexpr int kMaxPartitionSize = 4096;
+
+    // Sets up the partitioning and drops any loaded response (and its memory)
+    void prepare(double sampleRate, int maxBlockSize, int numChannels);
+    int getPartitionSize() const noexcept { return partitionSize; }
+    int getMaxImpulseSamples() const noexcept { return maxPartitions * partitionSize; }
+
+    // Background thread: a response transformed one partition at a time as it is rendered,
+    // so the time-domain response is never held in full
+    class Builder
+    {
+    public:
+        // Never alongside prepare() of `owner`
+        Builder(const ReverbSnapshot& owner, const ReverbSnapshotSettings& settings);
+        ~Builder();
+
+        // Appends the next partition: `numSamples` (at most the partition size) samples of
+        // each channel, scaled by `gain`. False once the response would exceed kMaxSeconds.
+        bool addPartition(const double* const* channels, int numSamples, double gain);
+
+        // Keeps only the partitions holding the first `length` samples
+        void trim(int length);
+
+    private:
+        friend class ReverbSnapshot;
+
+        int partitionSize, fftSize, spectrumSize, maxPartitions, numChannels;
+        juce::dsp::FFT transform;
+        std::vector<float> work;
+        std::unique_ptr<Kernel> kernel;
+
+        JUCE_DECLARE_NON_COPYABLE(Builder)
+    };
+
+    // Background thread (one call at a time, never alongside prepare()). Allocates the
+    // response's convolution state and posts it, replacing a posted response the audio
+    // thread has not picked up yet. False if the builder holds no samples.
+    bool post(Builder& builder);
+
+    // Audio thread: takes a posted response if the loaded one has rung out
+    void receive() noexcept;
+
+    // True if the loaded response was rendered with `settings`
+    bool matches(const ReverbSnapshotSettings& settings) const noexcept
+    {
+        return current != nullptr && current->settings == settings;
+    }
+
+    // True once the input has been silent for longer than the loaded response (or none is
+    // loaded): the output is silent and process() does nothing while that lasts
+    bool isIdle() const noexcept
+    {
+        return current == nullptr || silentSamples > current->length + partitionSize;
+    }
+
+    // Adds the convolution of the mono `input` to each of `numChannels` outputs.
+    // `inputSilent` says whether the block is below the sleep threshold.
+    void process(const float* input, bool inputSilent, SampleType* const* outputs,
+                 int numChannels, int numSamples) noexcept;
+
+    // Clears the convolution state (keeps the loaded response)
+    void reset();
+
+private:
+    struct Kernel
+    {
+        std::vector<float> spectra;       // Partition-major, numChannels spectra per partition
+        int numPartitions = 0;
+        int length = 0;
+        ReverbSnapshotSettings settings;
+
+        // Convolution state, allocated by post()
+        std::vector<float> history;       // Spectra of the last numPartitions input partitions
+        std::vector<float> inputBlock;    // Current partition, zero-padded to fftSize
+        std::vector<float> scratch;       // FFT workspace, 2 * fftSize
+        std::vector<float> tailSpectra;   // Per channel: older partitions, summed per partition
+        std::vector<float> pendingTail;   // Per channel: the next partition's, summed as this one plays
+        std::vector<float> overlap;       // Per channel: second half of the previous partition
+
+        void clearState();
+    };
+
+    // Runs samples [inputPos, inputPos + numSamples) of the current partition
+    void processPartial(const float* input, SampleType* const* outputs, int offset,
+                        int numChannels, int numSamples) noexcept;
+
+    // Kernel slot the background may write: neither posted nor in use
+    int claimKernel() noexcept;
+
+    // Handoff word: posted slot and slot in use, each -1 (none), 0 or 1
+    static int readyOf(int state) noexcept  { return (state & 3) - 1; }
+    static int inUseOf(int state) noexcept  { return ((state >> 2) & 3) - 1; }
+    static int packState(int ready, int inUse) noexcept { return (ready + 1) | ((inUse + 1) << 2); }
+
+    int partitionSize = kMinPartitionSize;
+    int fftOrder = 0;
+    int fftSize = 0;
+    int spectrumSize = 0;                 // Interleaved complex bins 0..fftSize / 2
+    int maxPartitions = 0;
+    int numChannels = 0;
+
+    std::unique_ptr<juce::dsp::FFT> fft;  // Audio thread only; builders use their own
+
+    int inputPos = 0;
+    int currentSegment = 0;
+    int deferredTerms = 0;                // Terms of the next partition in pendingTail so far
+    int silentSamples = 0;
+
+    Kernel kernels[2];
+    Kernel* current = nullptr;
+    std::atomic<int> handoff { packState(-1, -1) };
+
+    JUCE_DECLARE_NON_COPYABLE(ReverbSnapshot)
+};
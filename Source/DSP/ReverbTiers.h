@@ -0,0 +1,95 @@
+#pragma once
+
+// Allpass topologies for the ReverbEngine quality tiers. Each tier fixes its stage counts
+// at compile time, so the engine's allpass loops have constant trip counts, and brings
+// its own prime delay tables (lengths at 44.1kHz in samples, no prime used twice within
+// a tier). Every table covers the same span, so Size means the same room in each tier;
+// the tiers differ in how densely the span is filled.
+namespace ReverbTiers
+{
+    constexpr int kMaxOutputChannels = 12;      // 7.1.4
+
+    enum Quality
+    {
+        eco,
+        standard,
+        ultra,
+        numQualities
+    };
+
+    // Background ambience: 4 shared + 6 per-output stages
+    struct Eco
+    {
+        static constexpr int kNumSharedAllpasses = 4;
+        static constexpr int kNumChannelAllpasses = 6;
+
+        static constexpr int sharedDelays[kNumSharedAllpasses] = {
+            1049, 1361, 1657, 1951
+        };
+        static constexpr int channelDelays[kMaxOutputChannels][kNumChannelAllpasses] = {
+            { 1051, 1381, 1709, 2039, 2371, 2699 },
+            { 1063, 1399, 1723, 2053, 2381, 2711 },
+            { 1069, 1409, 1733, 2063, 2393, 2719 },
+            { 1087, 1423, 1747, 2081, 2411, 2731 },
+            { 1097, 1429, 1759, 2089, 2417, 2749 },
+            { 1109, 1439, 1777, 2099, 2423, 2753 },
+            { 1123, 1453, 1783, 2113, 2441, 2767 },
+            { 1129, 1471, 1789, 2129, 2459, 2789 },
+            { 1151, 1481, 1811, 2137, 2467, 2797 },
+            { 1163, 1489, 1823, 2153, 2477, 2803 },
+            { 1171, 1499, 1831, 2161, 2503, 2819 },
+            { 1181, 1511, 1847, 2179, 2521, 2833 },
+        };
+    };
+
+    // The original topology: 6 shared + 10 per-output stages
+    struct Standard
+    {
+        static constexpr int kNumSharedAllpasses = 6;      // Shorter mono chain → faster onset
+        static constexpr int kNumChannelAllpasses = 10;    // Longer per-output chains → density
+
+        static constexpr int sharedDelays[kNumSharedAllpasses] = {
+            1049, 1223, 1429, 1597, 1777, 1951
+        };
+        // One row per output channel (left, right, then the further outputs)
+        static constexpr int channelDelays[kMaxOutputChannels][kNumChannelAllpasses] = {
+            { 1051, 1249, 1453, 1627, 1801, 1979, 2153, 2333, 2521, 2699 },
+            { 1063, 1259, 1471, 1637, 1811, 1997, 2161, 2351, 2539, 2713 },
+            { 1087, 1277, 1481, 1657, 1831, 2011, 2203, 2371, 2549, 2729 },
+            { 1091, 1289, 1489, 1663, 1847, 2017, 2207, 2377, 2557, 2741 },
+            { 1103, 1301, 1511, 1693, 1861, 2029, 2213, 2383, 2579, 2749 },
+            { 1109, 1307, 1523, 1697, 1867, 2039, 2221, 2389, 2591, 2767 },
+            { 1123, 1319, 1531, 1699, 1871, 2053, 2237, 2411, 2593, 2777 },
+            { 1129, 1327, 1543, 1709, 1879, 2063, 2239, 2417, 2609, 2789 },
+            { 1151, 1361, 1549, 1721, 1901, 2081, 2251, 2437, 2617, 2791 },
+            { 1163, 1367, 1559, 1733, 1907, 2087, 2267, 2441, 2633, 2819 },
+            { 1171, 1373, 1567, 1741, 1913, 2099, 2269, 2447, 2647, 2833 },
+            { 1181, 1381, 1579, 1753, 1931, 2111, 2281, 2459, 2657, 2837 },
+        };
+    };
+
+    // Hero reverbs: 8 shared + 14 per-output stages
+    struct Ultra
+    {
+        static constexpr int kNumSharedAllpasses = 8;
+        static constexpr int kNumChannelAllpasses = 14;
+
+        static constexpr int sharedDelays[kNumSharedAllpasses] = {
+            1049, 1181, 1307, 1439, 1567, 1693, 1823, 1951
+        };
+        static constexpr int channelDelays[kMaxOutputChannels][kNumChannelAllpasses] = {
+            { 1051, 1171, 1303, 1433, 1559, 1697, 1811, 1933, 2063, 2203, 2311, 2447, 2579, 2699 },
+            { 1063, 1193, 1319, 1447, 1571, 1699, 1831, 1949, 2081, 2207, 2333, 2459, 2591, 2711 },
+            { 1069, 1201, 1327, 1453, 1583, 1709, 1847, 1973, 2089, 2213, 2341, 2467, 2593, 2719 },
+            { 1087, 1213, 1361, 1471, 1597, 1721, 1861, 1979, 2099, 2221, 2357, 2477, 2609, 2731 },
+            { 1097, 1229, 1367, 1481, 1607, 1733, 1867, 1987, 2113, 2239, 2371, 2503, 2621, 2749 },
+            { 1109, 1237, 1373, 1493, 1619, 1747, 1873, 1999, 2129, 2251, 2381, 2521, 2633, 2753 },
+            { 1123, 1249, 1381, 1499, 1627, 1759, 1889, 2011, 2137, 2267, 2393, 2531, 2647, 2767 },
+            { 1129, 1259, 1399, 1511, 1637, 1777, 1901, 2027, 2153, 2273, 2399, 2539, 2657, 2789 },
+            { 1151, 1277, 1409, 1531, 1657, 1783, 1907, 2039, 2161, 2287, 2417, 2543, 2671, 2797 },
+            { 1163, 1289, 1423, 1543, 1667, 1789, 1913, 2053, 2179, 2297, 2423, 2551, 2683, 2803 },
+            { 1187, 1297, 1427, 1553, 1669, 1801, 1931, 2069, 2143, 2309, 2441, 2557, 2693, 2819 },
+            { 1153, 1301, 1429, 1549, 1663, 1787, 1993, 2083, 2237, 2339, 2437, 2549, 2707, 2833 },
+        };
+    };
+}
@@ -0,0 +1,39 @@
+#include "SilenceDetector.h"
+
+template <typename SampleType>
+bool SilenceDetector::isSilent(const juce::AudioBuffer<SampleType>& buffer)
+{
+    const int numSamples = buffer.getNumSamples();
+
+    for (int ch = 0; ch < buffer.getNumChannels(); ++ch)
+        if (buffer.getMagnitude(ch, 0, numSamples) > static_cast<SampleType>(kThreshold))
+            return false;
+
+    return true;
+}
+
+void SilenceDetector::setHoldSamples(int samples)
+{
+    holdSamples = juce::jmax(0, samples);
+}
+
+template <typename SampleType>
+bool SilenceDetector::update(bool inputWasSilent, const juce::AudioBuffer<SampleType>& output)
+{
+    if (inputWasSilent && isSilent(output))
+        silentSamples = juce::jmin(holdSamples, silentSamples + output.getNumSamples());
+    else
+        silentSamples = 0;
+
+    return silentSamples >= holdSamples;
+}
+
+void SilenceDetector::reset()
+{
+    silentSamples = 0;
+}
+
+template bool SilenceDetector::isSilent(const juce::AudioBuffer<float>&);
+template bool SilenceDetector::isSilent(const juce::AudioBuffer<double>&);
+template bool SilenceDetector::update(bool, const juce::AudioBuffer<float>&);
+template bool SilenceDetector::update(bool, const juce::AudioBuffer<double>&);
@@ -0,0 +1,30 @@
+#pragma once
+#include <JuceHeader.h>
+
+// Decides when an engine may go to sleep: its input and its output must both stay
+// below the threshold for longer than the longest path through the engine, so
+// nothing audible can still be travelling through its delay lines.
+class SilenceDetector
+{
+public:
+    SilenceDetector() = default;
+
+    static constexpr float kThresholdDb = -100.0f;
+
+    template <typename SampleType>
+    static bool isSilent(const juce::AudioBuffer<SampleType>& buffer);
+
+    void setHoldSamples(int samples);
+
+    // Call after processing a block. Returns true once input and output have been
+    // silent for at least the hold time.
+    template <typename SampleType>
+    bool update(bool inputWasSilent, const juce::AudioBuffer<SampleType>& output);
+    void reset();
+
+private:
+    static constexpr float kThreshold = 1.0e-5f;   // kThresholdDb as linear gain
+
+    int holdSamples = 0;
+    int silentSamples = 0;
+};
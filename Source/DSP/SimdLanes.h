@@ -0,0 +1,34 @@
+#pragma once
+#include <JuceHeader.h>
+
+// Thin wrapper over juce::dsp::SIMDRegister for kernels that run independent channels side
+// by side, one channel per SIMD lane. Lane data lives in arrays aligned to kAlignment and
+// padded to a multiple of width<T>. Without SIMD support the "vector" is a single sample,
+// so the same kernels compile to plain scalar loops.
+namespace SimdLanes
+{
+    constexpr size_t kAlignment = 64;   // Covers every SIMD register size (and a cache line)
+
+#if JUCE_USE_SIMD
+    template <typename T> using Vector = juce::dsp::SIMDRegister<T>;
+    template <typename T> constexpr int width = static_cast<int>(Vector<T>::SIMDNumElements);
+
+    template <typename T> inline Vector<T> load(const T* lanes) noexcept       { return Vector<T>::fromRawArray(lanes); }
+    template <typename T> inline void store(T* lanes, Vector<T> v) noexcept    { v.copyToRawArray(lanes); }
+    template <typename T> inline Vector<T> broadcast(T value) noexcept         { return Vector<T>::expand(value); }
+#else
+    template <typename T> using Vector = T;
+    template <typename T> constexpr int width = 1;
+
+    template <typename T> inline Vector<T> load(const T* lanes) noexcept       { return *lanes; }
+    template <typename T> inline void store(T* lanes, Vector<T> v) noexcept    { *lanes = v; }
+    template <typename T> inline Vector<T> broadcast(T value) noexcept         { return value; }
+#endif
+
+    // Lane count rounded up to whole registers
+    template <typename T>
+    constexpr int paddedLanes(int numLanes) noexcept
+    {
+        return (numLanes + width<T> - 1) / width<T> * width<T>;
+    }
+}
@@ -0,0 +1,15 @@
+#pragma once
+#include <JuceHeader.h>
+
+// Parameter ramps shared by the engines and the mix stage. Setters only move a ramp's
+// target; the processor applies parameter changes once per chunk, so a change lands at
+// a chunk boundary rather than at its exact sample, and the ramp smooths it from there.
+
+// Jumps straight to the target right after prepare(), ramps afterwards
+inline void setSmoothedTarget(juce::SmoothedValue<float>& value, float target, bool snap)
+{
+    if (snap)
+        value.setCurrentAndTargetValue(target);
+    else
+        value.setTargetValue(target);
+}
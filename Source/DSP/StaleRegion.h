@@ -0,0 +1,103 @@
+#pragma once
+#include <JuceHeader.h>
+#include <algorithm>
+
+// What a circular delay line still holds from before its engine woke up with the sleep
+// clearing unfinished, cleared just ahead of the reads rather than all at once.
+//
+// Positions count from the write position at the wake-up; the stale ones were written
+// before it and not yet overwritten since. Before each block, clearAhead() zeroes the
+// stale positions the block can read, given the range its read distance stays within.
+// Once a position has been read the read position only moves on (as long as the delay
+// grows by less than a sample per sample, which every ramp here does), so from block to
+// block this clears about the block's length plus however far the delay moves, and ends
+// once the whole line has been written again or every stale position is clear.
+class StaleRegion
+{
+public:
+    // The whole line is stale from the write position `writePosition` back
+    void begin(juce::uint32 writePosition) noexcept
+    {
+        wakePosition = writePosition;
+        elapsed = 0;
+        hasCleared = false;
+        active = true;
+    }
+
+    void end() noexcept { active = false; }
+    bool isActive() const noexcept { return active; }
+
+    // Before a block of numSamples that reads between minDelay and maxDelay samples back
+    // (linearly interpolated: one sample further than the whole part). `mask` is the
+    // line's length - 1.
+    template <typename T>
+    void clearAhead(T* line, juce::uint32 mask, int numSamples, float minDelay, float maxDelay) noexcept
+    {
+        if (!active)
+            return;
+
+        const int length = static_cast<int>(mask) + 1;
+        if (elapsed >= length)
+        {
+            active = false;
+            return;
+        }
+
+        // A position a step further either side covers rounding in the modulation
+        const int nearest = static_cast<int>(std::floor(minDelay)) - 1;
+        const int furthest = static_cast<int>(std::floor(maxDelay)) + 2;
+
+        const int staleFrom = elapsed - length;
+        const int from = std::max(elapsed - furthest, staleFrom);
+        const int to = std::min(elapsed + numSamples - nearest, 0);
+
+        if (from < to)
+        {
+            if (!hasCleared)
+            {
+                zero(line, mask, from, to);
+                clearedFrom = from;
+                clearedTo = to;
+                hasCleared = true;
+            }
+            else
+            {
+                // Anything between the new range and the cleared one goes too, so the
+                // cleared positions stay one run
+                if (from < clearedFrom)
+                    zero(line, mask, from, clearedFrom);
+                if (to > clearedTo)
+                    zero(line, mask, std::max(clearedTo, staleFrom), to);
+
+                clearedFrom = std::min(clearedFrom, from);
+                clearedTo = std::max(clearedTo, to);
+            }
+        }
+
+        elapsed += numSamples;
+
+        if (hasCleared && clearedTo >= 0 && clearedFrom <= elapsed - length)
+            active = false;
+    }
+
+private:
+    // Zeroes positions [from, to), counted from the wake-up
+    template <typename T>
+    void zero(T* line, juce::uint32 mask, int from, int to) const noexcept
+    {
+        const auto length = static_cast<size_t>(mask) + 1;
+        const auto start = static_cast<size_t>((wakePosition + static_cast<juce::uint32>(from)) & mask);
+        const auto count = static_cast<size_t>(to - from);
+        const auto first = std::min(count, length - start);
+
+        std::fill(line + start, line + start + first, T(0));
+        std::fill(line, line + (count - first), T(0));
+    }
+
+    juce::uint32 wakePosition = 0;
+    int elapsed = 0;                   // Samples written since the wake-up
+    int clearedFrom = 0;               // [clearedFrom, clearedTo) zeroed, from the wake-up
+    int clearedTo = 0;
+    bool hasCleared = false;
+    bool active = false;
+};
@@ -1,9 +1,30 @@
 #include "PluginEditor.h"
 
+namespace
+{
+    constexpr int kLoadRefreshHz = 10;
+
+    constexpr int kTitleHeight = 50;
+    constexpr int kLoadHeight  = 90;
+
+    const char* const loadStageNames[LoadMeter::numStages] = { "Delay", "Reverb", "Mix", "Total" };
+}
+
 LogicTailAudioProcessorEditor::LogicTailAudioProcessorEditor (LogicTailAudioProcessor& p)
-    : AudioProcessorEditor (&p), processor (p)
+    : AudioProcessorEditor (&p), processor (p), levelMeters (p.getMeterTap()),
+      tailVisualizer (p.getReverbTap())
 {
-    setSize (420, 260);
+    addAndMakeVisible (levelMeters);
+    addAndMakeVisible (tailVisualizer);
+
+    // Morph snapshots: capture the current settings as A or B
+    storeAButton.onClick = [this] { processor.storeMorphSnapshot (0); };
+    storeBButton.onClick = [this] { processor.storeMorphSnapshot (1); };
+    addAndMakeVisible (storeAButton);
+    addAndMakeVisible (storeBButton);
+
+    setSize (680, 400);
+    startTimerHz (kLoadRefreshHz);
 }
 
 void LogicTailAudioProcessorEditor::paint (juce::Graphics& g)
@@ -11,7 +32,51 @@ void LogicTailAudioProcessorEditor::paint (juce::Graphics& g)
     g.fillAll (juce::Colours::black);
     g.setColour (juce::Colours::white);
     g.setFont (20.0f);
-    g.drawFittedText ("LogicTail", getLocalBounds(), juce::Justification::centred, 1);
+
+    auto bounds = getLocalBounds();
+    g.drawFittedText ("LogicTail", bounds.removeFromTop (kTitleHeight), juce::Justification::centred, 1);
+
+    // Processing load as a percentage of the block duration: rolling average / held peak
+    const auto& meter = processor.getLoadMeter();
+    g.setFont (13.0f);
+    g.setColour (juce::Colours::grey);
+
+    auto rows = bounds.removeFromBottom (kLoadHeight).reduced (20, 6);
+    const int rowHeight = rows.getHeight() / LoadMeter::numStages;
+
+    for (int stage = 0; stage < LoadMeter::numStages; ++stage)
+    {
+        const auto s = static_cast<LoadMeter::Stage> (stage);
+        const auto text = juce::String (loadStageNames[stage]) + "  "
+                        + juce::String (meter.getAverage (s) * 100.0f, 1) + " %  (peak "
+                        + juce::String (meter.getPeak (s) * 100.0f, 1) + " %)";
+
+        g.drawText (text, rows.removeFromTop (rowHeight), juce::Justification::centredLeft);
+    }
+}
+
+void LogicTailAudioProcessorEditor::resized()
+{
+    auto bounds = getLocalBounds();
+
+    auto title = bounds.removeFromTop (kTitleHeight).reduced (20, 12);
+    storeBButton.setBounds (title.removeFromRight (70));
+    title.removeFromRight (8);
+    storeAButton.setBounds (title.removeFromRight (70));
+    bounds.removeFromBottom (kLoadHeight);
+    bounds.reduce (20, 4);
+    levelMeters.setBounds (bounds.removeFromLeft (bounds.getWidth() / 2 - 10));
+    bounds.removeFromLeft (20);
+    tailVisualizer.setBounds (bounds);
 }
 
-void LogicTailAudioProcessorEditor::resized() {}
+void LogicTailAudioProcessorEditor::mouseDown (const juce::MouseEvent&)
+{
+    processor.getLoadMeter().resetPeaks();
+}
+
+void LogicTailAudioProcessorEditor::timerCallback()
+{
+    // Only the load readout — the level meters refresh themselves on vblank
+    repaint (getLocalBounds().removeFromBottom (kLoadHeight));
+}
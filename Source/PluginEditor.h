@@ -1,8 +1,11 @@
 #pragma once
 #include <JuceHeader.h>
 #include "PluginProcessor.h"
+#include "UI/LevelMeters.h"
+#include "UI/TailVisualizer.h"
 
-class LogicTailAudioProcessorEditor : public juce::AudioProcessorEditor
+class LogicTailAudioProcessorEditor : public juce::AudioProcessorEditor,
+                                      private juce::Timer
 {
 public:
     explicit LogicTailAudioProcessorEditor (LogicTailAudioProcessor&);
@@ -11,7 +14,16 @@ public:
     void paint (juce::Graphics&) override;
     void resized() override;
 
+    // Clicking the editor resets the held load peaks
+    void mouseDown (const juce::MouseEvent&) override;
+
 private:
+    void timerCallback() override;
+
     LogicTailAudioProcessor& processor;
+    LevelMeters levelMeters;
+    TailVisualizer tailVisualizer;
+    juce::TextButton storeAButton { "Store A" };
+    juce::TextButton storeBButton { "Store B" };
     JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR (LogicTailAudioProcessorEditor)
 };
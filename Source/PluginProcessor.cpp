@@ -1,82 +1,286 @@
 #include "PluginProcessor.h"
 #include "PluginEditor.h"
 #include "Utility/ParameterLayout.h"
+#include "Utility/AllocationGuard.h"
+#include "Utility/StateSerializer.h"
+
+namespace
+{
+    // Parallel routing hands the reverb to the worker thread only when both engines have
+    // enough work per chunk to amortise the hand-off. Offline renders have no deadline
+    // to protect, so they go concurrent at smaller blocks.
+    constexpr int kMinConcurrentSamplesRealtime = 1024;
+    constexpr int kMinConcurrentSamplesOffline  = 256;
+
+    // Morphing re-applies the blended snapshot every kMorphControlSamples samples; the
+    // morph position glides towards the Morph parameter with this time constant
+    constexpr int kMorphControlSamples = 64;
+    constexpr double kMorphSmoothingSeconds = 0.05;
+
+    // How often the message thread checks the EQ settings for a new coefficient set
+    constexpr int kCoefficientPublishHz = 60;
+
+    // An impulse response snapshot is rendered once the reverb settings have held still this long
+    constexpr int kSnapshotSettleTicks = kCoefficientPublishHz / 2;
+
+    // The meter parameters are refreshed every this many timer ticks (10 Hz)
+    constexpr int kLoadPublishTicks = kCoefficientPublishHz / 10;
+
+    template <typename SampleType>
+    struct ReverbJob
+    {
+        ReverbSection<SampleType>& engine;
+        juce::AudioBuffer<SampleType>& buffer;
+        LoadMeter& loadMeter;
+
+        static void run (void* context)
+        {
+            auto& job = *static_cast<ReverbJob*> (context);
+            const LoadMeter::ScopedStage timer (job.loadMeter, LoadMeter::reverb);
+            job.engine.process(job.buffer);
+        }
+    };
+
+    // Reverb EQ settings a recalled state will produce; `plainValueOf (id)` returns the
+    // state's plain value for a parameter ID
+    template <typename ValueLookup>
+    ReverbEqSettings recalledEqSettings (ValueLookup&& plainValueOf)
+    {
+        ReverbEqSettings settings;
+        settings.loEQdB = plainValueOf (ParameterIDs::reverb_lo);
+        settings.hiEQdB = plainValueOf (ParameterIDs::reverb_hi);
+        settings.resonance = plainValueOf (ParameterIDs::reverb_resonance);
+        settings.feedbackAmount = ReverbEqSettings::feedbackPercentToAmount (plainValueOf (ParameterIDs::reverb_feedback));
+        return settings;
+    }
+
+    float defaultPlainValue (const juce::AudioProcessorValueTreeState& apvts, const char* id)
+    {
+        auto* param = apvts.getParameter (id);
+        return param != nullptr ? param->convertFrom0to1 (param->getDefaultValue()) : 0.0f;
+    }
+
+    ReverbEqSettings eqSettingsOf (const ParameterSnapshot& p)
+    {
+        return { p.loEQ, p.hiEQ, p.resonance, ReverbEqSettings::feedbackPercentToAmount (p.revFeedback) };
+    }
+
+    // The values applyParameterChanges() hands the reverb setters
+    ReverbSnapshotSettings snapshotSettingsOf (const ParameterSnapshot& p)
+    {
+        ReverbSnapshotSettings settings;
+        settings.gravity   = p.gravity;
+        settings.size      = p.size;
+        settings.preDelay  = p.preDelay;
+        settings.feedback  = p.revFeedback;
+        settings.modDepth  = p.revModDepth;
+        settings.loEQ      = p.loEQ;
+        settings.hiEQ      = p.hiEQ;
+        settings.resonance = p.resonance;
+        settings.freeze    = p.freeze;
+        settings.quality   = p.reverbQuality;
+        settings.algorithm = p.reverbAlgorithm;
+        return settings;
+    }
+}
 
 LogicTailAudioProcessor::LogicTailAudioProcessor()
     : AudioProcessor (BusesProperties()
         .withInput  ("Input",  juce::AudioChannelSet::stereo(), true)
         .withOutput ("Output", juce::AudioChannelSet::stereo(), true))
     , apvts (*this, nullptr, "Parameters", createParameterLayout())
+    , parameterCache (apvts)
 {
+    const char* const loadIDs[LoadMeter::numStages][2] = {
+        { ParameterIDs::load_delay,  ParameterIDs::load_delay_peak },
+        { ParameterIDs::load_reverb, ParameterIDs::load_reverb_peak },
+        { ParameterIDs::load_mix,    ParameterIDs::load_mix_peak },
+        { ParameterIDs::load_total,  ParameterIDs::load_total_peak },
+    };
+
+    for (int stage = 0; stage < LoadMeter::numStages; ++stage)
+    {
+        loadParameters[stage].average = apvts.getParameter (loadIDs[stage][0]);
+        loadParameters[stage].peak    = apvts.getParameter (loadIDs[stage][1]);
+    }
+
+    startTimerHz (kCoefficientPublishHz);
 }
 
 void LogicTailAudioProcessor::prepareToPlay (double sampleRate, int samplesPerBlock)
 {
-    delayEngine.prepare(sampleRate, samplesPerBlock);
-    reverbEngine.prepare(sampleRate, samplesPerBlock);
+    // A snapshot still rendering was set up for the old rate and block size
+    cancelSnapshotRender();
+
+    preparedBlockSize = juce::jmax (1, samplesPerBlock);
+    mixStage.prepare(sampleRate);
+    loadMeter.prepare (sampleRate);
+    meterTap.prepare (sampleRate);
+    reverbTap.prepare (sampleRate);
+
+    ParameterSnapshot params;
+    parameterCache.read (params);
+
+    // The reverb runs at the rate Tail Rate allows here; its coefficients are designed for that rate
+    preparedTailRate = params.tailRate;
+    tailSampleRate.store (sampleRate / ReverbSection<float>::decimationFor (sampleRate, preparedTailRate));
+
+    // Morph slots carry coefficients for the rate they were stored at — redesign them
+    receiveMorphSlots();
+    redesignMorphSlots();
+
+    morphActive = false;
+
+    // Engines were re-prepared — push every parameter now so the tail estimate is
+    // valid before the first block (the playhead BPM is picked up once playing)
+    needsFullParameterUpdate = true;
+
+    // Only the engine set matching the host's precision is allocated (the host calls
+    // prepareToPlay again whenever it switches precision)
+    if (isUsingDoublePrecision())
+    {
+        prepareEngines (doubleEngines, sampleRate);
+        applyParameterChanges (doubleEngines, params, 120.0);
+    }
+    else
+    {
+        prepareEngines (floatEngines, sampleRate);
+        applyParameterChanges (floatEngines, params, 120.0);
+    }
+}
+
+template <typename SampleType>
+void LogicTailAudioProcessor::prepareEngines (EngineSet<SampleType>& engines, double sampleRate)
+{
+    const int numChannels = juce::jmax (getTotalNumInputChannels(), getTotalNumOutputChannels(), 2);
+
+    engines.dryBuffer.setSize (numChannels, preparedBlockSize);
+    engines.reverbBuffer.setSize (numChannels, preparedBlockSize);
+
+    engines.delay.prepare(sampleRate, preparedBlockSize);
+    prepareReverb (engines, sampleRate);
+}
+
+template <typename SampleType>
+void LogicTailAudioProcessor::prepareReverb (EngineSet<SampleType>& engines, double sampleRate)
+{
+    const int numChannels = juce::jmax (getTotalNumInputChannels(), getTotalNumOutputChannels(), 2);
+    const int decimation = ReverbSection<SampleType>::decimationFor (sampleRate, preparedTailRate);
+
+    engines.reverb.prepare(sampleRate, preparedBlockSize, numChannels, decimation);
+}
+
+void LogicTailAudioProcessor::applyTailRate (int tailRate)
+{
+    preparedTailRate = tailRate;
+
+    // Before the first prepareToPlay there is nothing to rebuild; prepare reads the setting
+    const double sampleRate = getSampleRate();
+    if (sampleRate <= 0.0 || preparedBlockSize == 0)
+        return;
+
+    // At lower host rates several settings share a decimation (all run at full rate at 48 kHz)
+    const double newTailSampleRate = sampleRate / ReverbSection<float>::decimationFor (sampleRate, tailRate);
+    if (newTailSampleRate == tailSampleRate.load())
+        return;
+
+    // Re-preparing the reverb allocates, so the host holds off processBlock meanwhile.
+    // The running tail is lost, as on any prepareToPlay.
+    cancelSnapshotRender();
+    suspendProcessing (true);
+
+    tailSampleRate.store (newTailSampleRate);
+
+    if (isUsingDoublePrecision())
+        prepareReverb (doubleEngines, sampleRate);
+    else
+        prepareReverb (floatEngines, sampleRate);
+
+    receiveMorphSlots();
+    redesignMorphSlots();
+    morphActive = false;
+    needsFullParameterUpdate = true;
+
+    suspendProcessing (false);
+}
+
+void LogicTailAudioProcessor::redesignMorphSlots()
+{
+    const double sampleRate = tailSampleRate.load();
+    for (auto& slot : morphSlots)
+        if (slot.stored)
+            slot.coefficients = ReverbCoefficientSet::design (sampleRate, eqSettingsOf (slot.parameters));
 }
 
 void LogicTailAudioProcessor::releaseResources()
 {
-    delayEngine.reset();
-    reverbEngine.reset();
+    parallelWorker.stop();
+
+    floatEngines.delay.reset();
+    floatEngines.reverb.reset();
+    doubleEngines.delay.reset();
+    doubleEngines.reverb.reset();
 }
 
 bool LogicTailAudioProcessor::isBusesLayoutSupported (const BusesLayout& layouts) const
 {
-    return layouts.getMainOutputChannelSet() == juce::AudioChannelSet::stereo();
+    const auto& in  = layouts.getMainInputChannelSet();
+    const auto& out = layouts.getMainOutputChannelSet();
+
+    // Any output layout the reverb has chains for (mono up to 7.1.4), fed from a mono
+    // input or the same layout. The delay runs on the first two channels only.
+    if (out.isDisabled() || out.size() > ReverbSection<float>::kMaxOutputChannels)
+        return false;
+
+    return in == juce::AudioChannelSet::mono() || in == out;
 }
 
 void LogicTailAudioProcessor::processBlock (juce::AudioBuffer<float>& buffer, juce::MidiBuffer&)
+{
+    const ScopedAllocationGuard noAllocations;
+    {
+        const LoadMeter::ScopedStage timer (loadMeter, LoadMeter::total);
+        processBlockInternal (buffer, floatEngines);
+    }
+    loadMeter.endBlock (buffer.getNumSamples());
+}
+
+void LogicTailAudioProcessor::processBlock (juce::AudioBuffer<double>& buffer, juce::MidiBuffer&)
+{
+    const ScopedAllocationGuard noAllocations;
+    {
+        const LoadMeter::ScopedStage timer (loadMeter, LoadMeter::total);
+        processBlockInternal (buffer, doubleEngines);
+    }
+    loadMeter.endBlock (buffer.getNumSamples());
+}
+
+void LogicTailAudioProcessor::publishLoadParameters()
+{
+    if (++loadPublishTicks < kLoadPublishTicks)
+        return;
+
+    loadPublishTicks = 0;
+
+    // Meter parameters are normalised 0..1 = 0..100 % of the block duration
+    for (int stage = 0; stage < LoadMeter::numStages; ++stage)
+    {
+        const auto s = static_cast<LoadMeter::Stage> (stage);
+        if (auto* p = loadParameters[stage].average)
+            p->setValueNotifyingHost (juce::jlimit (0.0f, 1.0f, loadMeter.getAverage (s)));
+        if (auto* p = loadParameters[stage].peak)
+            p->setValueNotifyingHost (juce::jlimit (0.0f, 1.0f, loadMeter.getPeak (s)));
+    }
+}
+
+template <typename SampleType>
+void LogicTailAudioProcessor::processBlockInternal (juce::AudioBuffer<SampleType>& buffer, EngineSet<SampleType>& engines)
 {
     juce::ScopedNoDenormals noDenormals;
 
-    // Read reverb parameters
-    float gravity = apvts.getRawParameterValue(ParameterIDs::reverb_gravity)->load();
-    float size = apvts.getRawParameterValue(ParameterIDs::reverb_size)->load();
-    float preDelay = apvts.getRawParameterValue(ParameterIDs::reverb_predelay)->load();
-    float revFeedback = apvts.getRawParameterValue(ParameterIDs::reverb_feedback)->load();
-    float revModDepth = apvts.getRawParameterValue(ParameterIDs::reverb_mod_depth)->load();
-    float revModRate = apvts.getRawParameterValue(ParameterIDs::reverb_mod_rate)->load();
-    float loEQ = apvts.getRawParameterValue(ParameterIDs::reverb_lo)->load();
-    float hiEQ = apvts.getRawParameterValue(ParameterIDs::reverb_hi)->load();
-    float resonance = apvts.getRawParameterValue(ParameterIDs::reverb_resonance)->load();
-    bool freeze = apvts.getRawParameterValue(ParameterIDs::reverb_freeze)->load() > 0.5f;
-    bool killDry = apvts.getRawParameterValue(ParameterIDs::reverb_kill_dry)->load() > 0.5f;
-
-    // Read delay parameters
-    float delTime     = apvts.getRawParameterValue(ParameterIDs::delay_time)->load();
-    float delFeedback = apvts.getRawParameterValue(ParameterIDs::delay_feedback)->load();
-    float delHP       = apvts.getRawParameterValue(ParameterIDs::delay_hp)->load();
-    float delLP       = apvts.getRawParameterValue(ParameterIDs::delay_lp)->load();
-    bool  delSync     = apvts.getRawParameterValue(ParameterIDs::delay_sync)->load() > 0.5f;
-    // AudioParameterChoice stores the selected index as a float directly
-    int   delDivision = static_cast<int>(
-        apvts.getRawParameterValue(ParameterIDs::delay_division)->load());
-    bool  delPingPong = apvts.getRawParameterValue(ParameterIDs::delay_pingpong)->load() > 0.5f;
-    float delModRate  = apvts.getRawParameterValue(ParameterIDs::delay_mod_rate)->load();
-    float delModDepth = apvts.getRawParameterValue(ParameterIDs::delay_mod_depth)->load();
-
-    // Read global parameters
-    int routingIdx = static_cast<int>(apvts.getRawParameterValue(ParameterIDs::routing_mode)->load());
-    float balance = apvts.getRawParameterValue(ParameterIDs::parallel_balance)->load() / 100.0f;
-    float mix = apvts.getRawParameterValue(ParameterIDs::global_mix)->load() / 100.0f;
-    float inGain = juce::Decibels::decibelsToGain(apvts.getRawParameterValue(ParameterIDs::input_gain)->load());
-    float outGain = juce::Decibels::decibelsToGain(apvts.getRawParameterValue(ParameterIDs::output_gain)->load());
-
-    // Update reverb engine
-    reverbEngine.setGravity(gravity);
-    reverbEngine.setSize(size);
-    reverbEngine.setPreDelay(preDelay);
-    reverbEngine.setFeedback(revFeedback);
-    reverbEngine.setModulation(revModDepth, revModRate);
-    reverbEngine.setLoEQ(loEQ);
-    reverbEngine.setHiEQ(hiEQ);
-    reverbEngine.setResonance(resonance);
-    reverbEngine.setFreeze(freeze);
-    reverbEngine.setKillDry(killDry);
+    ParameterSnapshot params;
+    parameterCache.read (params);
 
-    // Update delay engine
     // BPM from DAW playhead (fallback 120 when offline/no transport)
     double bpm = 120.0;
     if (auto* ph = getPlayHead())
@@ -84,91 +288,336 @@ void LogicTailAudioProcessor::processBlock (juce::AudioBuffer<float>& buffer, ju
             if (pos->getBpm().hasValue())
                 bpm = *pos->getBpm();
 
-    if (delSync)
-        delayEngine.setTempoSync(true, bpm, delDivision);
+    // Morphing needs both snapshots, with coefficients designed for the current rate
+    receiveMorphSlots();
+    const double sampleRate = tailSampleRate.load (std::memory_order_relaxed);
+    const bool morphing = params.morphEnabled
+        && morphSlots[0].stored && morphSlots[0].coefficients.sampleRate == sampleRate
+        && morphSlots[1].stored && morphSlots[1].coefficients.sampleRate == sampleRate;
+
+    if (morphing && ! morphActive)
+    {
+        // Start from the current Morph value rather than gliding in from the last position
+        morphActive = true;
+        morphPosition = juce::jlimit (0.0f, 1.0f, params.morph / 100.0f);
+        morphCoefficientsDirty = true;
+    }
+    else if (! morphing)
+    {
+        // Leaving morph mode: the engine rebuilds its EQ from the live settings
+        if (morphActive)
+            engines.reverb.invalidateCoefficients();
+
+        morphActive = false;
+
+        // Coefficients either arrive designed from the message thread or are rebuilt
+        // with the plain-math designers, so parameter changes never allocate
+        applyParameterChanges (engines, params, bpm);
+    }
+
+    // Mono in → stereo out: the host leaves the second channel undefined, so start
+    // from a centred copy of the input (engines and mix then run as plain stereo)
+    const int numInputChannels = getTotalNumInputChannels();
+    for (int ch = numInputChannels; ch < getTotalNumOutputChannels(); ++ch)
+    {
+        if (numInputChannels > 0)
+            buffer.copyFrom (ch, 0, buffer, 0, 0, buffer.getNumSamples());
+        else
+            buffer.clear (ch, 0, buffer.getNumSamples());
+    }
+
+    // Hosts may deliver more samples than announced in prepareToPlay. Rather than
+    // growing the scratch buffers here, split the block into prepared-size chunks.
+    const int numChannels = juce::jmin (buffer.getNumChannels(), engines.dryBuffer.getNumChannels());
+    const int numSamples  = buffer.getNumSamples();
+    jassert (numChannels == buffer.getNumChannels());
+
+    // While morphing, chunks double as control ticks
+    const int maxChunkSize = morphActive ? juce::jmin (preparedBlockSize, kMorphControlSamples)
+                                         : preparedBlockSize;
+
+    for (int start = 0; start < numSamples; start += maxChunkSize)
+    {
+        const int chunkSize = juce::jmin (maxChunkSize, numSamples - start);
+
+        if (morphActive)
+            applyMorphTick (engines, params, bpm, chunkSize);
+
+        // Non-owning view onto the host buffer (no heap use below 32 channels)
+        juce::AudioBuffer<SampleType> chunk (buffer.getArrayOfWritePointers(), numChannels, start, chunkSize);
+        processChunk (chunk, engines, appliedParameters.routingIdx);
+    }
+}
+
+template <typename SampleType>
+void LogicTailAudioProcessor::applyParameterChanges (EngineSet<SampleType>& engines, const ParameterSnapshot& p, double bpm)
+{
+    auto& reverbEngine = engines.reverb;
+    auto& delayEngine  = engines.delay;
+
+    const auto& prev = appliedParameters;
+    const bool all = needsFullParameterUpdate;
+
+    // Update reverb engine — setters only run for values that moved since the last block
+    if (all || p.gravity != prev.gravity)       reverbEngine.setGravity(p.gravity);
+    if (all || p.size != prev.size)             reverbEngine.setSize(p.size);
+    if (all || p.preDelay != prev.preDelay)     reverbEngine.setPreDelay(p.preDelay);
+    if (all || p.revFeedback != prev.revFeedback) reverbEngine.setFeedback(p.revFeedback);
+    if (all || p.revModDepth != prev.revModDepth || p.revModRate != prev.revModRate)
+        reverbEngine.setModulation(p.revModDepth, p.revModRate);
+    if (all || p.loEQ != prev.loEQ)             reverbEngine.setLoEQ(p.loEQ);
+    if (all || p.hiEQ != prev.hiEQ)             reverbEngine.setHiEQ(p.hiEQ);
+    if (all || p.resonance != prev.resonance)   reverbEngine.setResonance(p.resonance);
+    if (all || p.freeze != prev.freeze)         reverbEngine.setFreeze(p.freeze);
+    if (all || p.killDry != prev.killDry)       reverbEngine.setKillDry(p.killDry);
+    if (all || p.reverbQuality != prev.reverbQuality) reverbEngine.setQuality(p.reverbQuality);
+    if (all || p.reverbAlgorithm != prev.reverbAlgorithm) reverbEngine.setAlgorithm(p.reverbAlgorithm);
+    if (all || p.reverbSnapshot != prev.reverbSnapshot) reverbEngine.setSnapshotEnabled(p.reverbSnapshot);
+
+    // While morphing, the EQ is the lattice-domain blend of the A/B sets. Otherwise a
+    // coefficient set published from the message thread is installed as a plain copy
+    // once the matching values have arrived, replacing the rebuilds they would trigger.
+    // Settings no published set matches yet (mid-sweep) are rebuilt here.
+    if (morphActive)
+    {
+        if (morphCoefficientsDirty)
+            reverbEngine.interpolateCoefficients (morphSlots[0].coefficients, morphSlots[1].coefficients, morphPosition);
+
+        morphCoefficientsDirty = false;
+    }
+    else
+    {
+        publishedCoefficients.consumeIf ([&reverbEngine] (const ReverbCoefficientSet& set)
+                                      { return reverbEngine.installCoefficients (set); });
+    }
+
+    reverbEngine.updateCoefficients();
+
+    // Update delay engine
+    const bool timingChanged = all
+        || p.delSync != prev.delSync
+        || p.delDivision != prev.delDivision
+        || p.delTime != prev.delTime
+        || (p.delSync && bpm != appliedBpm);
+
+    if (timingChanged)
+    {
+        if (p.delSync)
+            delayEngine.setTempoSync(true, bpm, p.delDivision);
+        else
+        {
+            delayEngine.setTempoSync(false, 0.0, 0);
+            delayEngine.setDelayTime(p.delTime);
+        }
+    }
+
+    if (all || p.delFeedback != prev.delFeedback) delayEngine.setFeedback(p.delFeedback);
+    if (all || p.delHP != prev.delHP)             delayEngine.setHighPassFreq(p.delHP);
+    if (all || p.delLP != prev.delLP)             delayEngine.setLowPassFreq(p.delLP);
+    if (all || p.delPingPong != prev.delPingPong) delayEngine.setPingPong(p.delPingPong);
+    if (all || p.delModRate != prev.delModRate || p.delModDepth != prev.delModDepth)
+        delayEngine.setModulation(p.delModRate, p.delModDepth);
+
+    // Update global mix stage
+    if (all || p.inputGain != prev.inputGain)   mixStage.setInputGain(juce::Decibels::decibelsToGain(p.inputGain));
+    if (all || p.outputGain != prev.outputGain) mixStage.setOutputGain(juce::Decibels::decibelsToGain(p.outputGain));
+    if (all || p.balance != prev.balance)       mixStage.setBalance(p.balance / 100.0f);
+    if (all || p.mix != prev.mix)               mixStage.setMix(p.mix / 100.0f);
+    if (all || p.killDry != prev.killDry)       mixStage.setKillDry(p.killDry);
+    if (all || p.mixLaw != prev.mixLaw)
+        mixStage.setCrossfadeLaw(p.mixLaw == 1 ? MixStage::CrossfadeLaw::EqualPower
+                                               : MixStage::CrossfadeLaw::Linear);
+
+    const bool tailChanged = all || timingChanged
+        || p.gravity != prev.gravity
+        || p.size != prev.size
+        || p.preDelay != prev.preDelay
+        || p.revFeedback != prev.revFeedback
+        || p.revModDepth != prev.revModDepth
+        || p.loEQ != prev.loEQ
+        || p.hiEQ != prev.hiEQ
+        || p.freeze != prev.freeze
+        || p.reverbQuality != prev.reverbQuality
+        || p.reverbAlgorithm != prev.reverbAlgorithm
+        || p.delFeedback != prev.delFeedback
+        || p.delModDepth != prev.delModDepth
+        || p.routingIdx != prev.routingIdx
+        || p.balance != prev.balance;
+
+    if (tailChanged)
+        updateTailLength (engines, p.routingIdx, p.balance / 100.0f);
+
+    appliedParameters = p;
+    appliedBpm = bpm;
+    needsFullParameterUpdate = false;
+}
+
+template <typename SampleType>
+void LogicTailAudioProcessor::applyMorphTick (EngineSet<SampleType>& engines, const ParameterSnapshot& live,
+                                              double bpm, int numSamples)
+{
+    const float target = juce::jlimit (0.0f, 1.0f, live.morph / 100.0f);
+    const auto glide = static_cast<float> (1.0 - std::exp (-numSamples / (kMorphSmoothingSeconds * getSampleRate())));
+
+    float position = morphPosition + (target - morphPosition) * glide;
+    if (std::abs (target - position) < 1.0e-4f)
+        position = target;
+
+    if (position != morphPosition)
+    {
+        morphPosition = position;
+        morphCoefficientsDirty = true;
+    }
+
+    // Only the setters whose blended value moved run (see applyParameterChanges)
+    auto blended = interpolateSnapshots (morphSlots[0].parameters, morphSlots[1].parameters, morphPosition);
+    blended.morph = live.morph;
+    blended.morphEnabled = live.morphEnabled;
+
+    applyParameterChanges (engines, blended, bpm);
+}
+
+template <typename SampleType>
+void LogicTailAudioProcessor::updateTailLength (const EngineSet<SampleType>& engines, int routingIdx, float balance)
+{
+    const double delayTail  = engines.delay.getTailLengthSeconds();
+    const double reverbTail = engines.reverb.getTailLengthSeconds();
+
+    double tail;
+    if (routingIdx == 2)
+    {
+        // Parallel: the tails overlap, unless the balance mutes one engine entirely
+        if (balance >= 0.99f)      tail = reverbTail;
+        else if (balance <= 0.01f) tail = delayTail;
+        else                       tail = juce::jmax (delayTail, reverbTail);
+    }
     else
     {
-        delayEngine.setTempoSync(false, 0.0, 0);
-        delayEngine.setDelayTime(delTime);
+        // Series: the second engine keeps ringing after the first one's tail ends
+        tail = delayTail + reverbTail;
     }
 
-    delayEngine.setFeedback(delFeedback);
-    delayEngine.setHighPassFreq(delHP);
-    delayEngine.setLowPassFreq(delLP);
-    delayEngine.setPingPong(delPingPong);
-    delayEngine.setModulation(delModRate, delModDepth);
+    // Infinity (freeze) is reported to VST3 hosts as an infinite tail
+    tailLengthSeconds.store (tail, std::memory_order_relaxed);
+}
+
+template <typename SampleType>
+void LogicTailAudioProcessor::processChunk (juce::AudioBuffer<SampleType>& buffer, EngineSet<SampleType>& engines, int routingIdx)
+{
+    auto& delayEngine  = engines.delay;
+    auto& reverbEngine = engines.reverb;
+    auto& dryBuffer    = engines.dryBuffer;
+    auto& reverbBuffer = engines.reverbBuffer;
+
+    // Every engine call is timed into its LoadMeter stage and tapped for the meters
+    auto runDelay = [this, &delayEngine] (juce::AudioBuffer<SampleType>& b)
+    {
+        {
+            const LoadMeter::ScopedStage timer (loadMeter, LoadMeter::delay);
+            delayEngine.process(b);
+        }
+        meterTap.measure (MeterFrame::delay, b);
+    };
+    auto tapReverb = [this, &reverbEngine] (const juce::AudioBuffer<SampleType>& b)
+    {
+        reverbTap.write (b);
+        meterTap.measure (MeterFrame::reverb, b);
+        const int rightChannel = b.getNumChannels() > 1 ? 1 : 0;
+        meterTap.measureFeedback (reverbEngine.getFeedbackSample (0), reverbEngine.getFeedbackSample (rightChannel));
+    };
+    auto runReverb = [this, &reverbEngine, &tapReverb] (juce::AudioBuffer<SampleType>& b)
+    {
+        ReverbJob<SampleType> job { reverbEngine, b, loadMeter };
+        ReverbJob<SampleType>::run (&job);
+        tapReverb (b);
+    };
 
-    // Apply input gain
-    buffer.applyGain(inGain);
+    mixStage.beginChunk(buffer.getNumSamples());
 
-    // Store dry signal
-    juce::AudioBuffer<float> dryBuffer;
-    dryBuffer.makeCopyOf(buffer);
+    // Parallel blend needs a second copy of the input for the reverb
+    const bool parallelBlend = routingIdx == 2 && mixStage.needsDelay() && mixStage.needsReverb();
+    auto* reverbSend = parallelBlend ? &reverbBuffer : nullptr;
+
+    // Pass 1: input gain + dry copy (+ reverb send)
+    {
+        const LoadMeter::ScopedStage timer (loadMeter, LoadMeter::mix);
+        mixStage.processInput(buffer, dryBuffer, reverbSend);
+    }
+    meterTap.measure (MeterFrame::input, buffer);
 
     // --- ROUTING ---
     if (routingIdx == 0)
     {
         // Series: Delay → Reverb
-        delayEngine.process(buffer);
-        reverbEngine.process(buffer);
+        runDelay (buffer);
+        runReverb (buffer);
     }
     else if (routingIdx == 1)
     {
         // Series: Reverb → Delay
-        reverbEngine.process(buffer);
-        delayEngine.process(buffer);
+        runReverb (buffer);
+        runDelay (buffer);
     }
-    else
+    else if (parallelBlend)
     {
-        // Parallel — skip unused engine when balance is at an extreme
-        if (balance >= 0.99f)
-        {
-            // 100% reverb — skip delay entirely
-            reverbEngine.process(buffer);
-        }
-        else if (balance <= 0.01f)
+        // Parallel — both engines, blended by the mix stage
+        juce::AudioBuffer<SampleType> reverbChunk (reverbBuffer.getArrayOfWritePointers(),
+                                                   buffer.getNumChannels(), 0, buffer.getNumSamples());
+
+        if (shouldRunConcurrently (engines, buffer.getNumSamples()))
         {
-            // 100% delay — skip reverb entirely
-            delayEngine.process(buffer);
+            // Reverb on the worker while the delay runs here
+            ReverbJob<SampleType> job { reverbEngine, reverbChunk, loadMeter };
+            parallelWorker.launch (&ReverbJob<SampleType>::run, &job);
+            runDelay (buffer);
+            parallelWorker.join();
+            tapReverb (reverbChunk);
         }
         else
         {
-            // Blend both engines
-            juce::AudioBuffer<float> reverbBuffer;
-            reverbBuffer.makeCopyOf(buffer);
-
-            delayEngine.process(buffer);        // buffer now = delay wet
-            reverbEngine.process(reverbBuffer); // reverbBuffer = reverb wet
-
-            // Blend: balance 0 = all delay, 100 = all reverb
-            for (int ch = 0; ch < buffer.getNumChannels(); ++ch)
-            {
-                auto* delData = buffer.getWritePointer(ch);
-                const auto* revData = reverbBuffer.getReadPointer(ch);
-                for (int i = 0; i < buffer.getNumSamples(); ++i)
-                {
-                    delData[i] = delData[i] * (1.0f - balance) + revData[i] * balance;
-                }
-            }
+            runDelay (buffer);        // buffer now = delay wet
+            runReverb (reverbChunk);  // reverbChunk = reverb wet
         }
     }
+    else if (mixStage.needsReverb())
+    {
+        // Parallel at 100% reverb — skip delay entirely
+        runReverb (buffer);
+    }
+    else
+    {
+        // Parallel at 100% delay — skip reverb entirely
+        runDelay (buffer);
+    }
 
-    // --- DRY/WET MIX ---
-    for (int ch = 0; ch < buffer.getNumChannels(); ++ch)
+    // Pass 2: parallel balance + dry/wet + output gain
     {
-        auto* wet = buffer.getWritePointer(ch);
-        const auto* dry = dryBuffer.getReadPointer(ch);
-        for (int i = 0; i < buffer.getNumSamples(); ++i)
-        {
-            if (killDry)
-                wet[i] = wet[i];  // 100% wet when kill dry is on
-            else
-                wet[i] = dry[i] * (1.0f - mix) + wet[i] * mix;
-        }
+        const LoadMeter::ScopedStage timer (loadMeter, LoadMeter::mix);
+        mixStage.processOutput(buffer, dryBuffer, reverbSend);
+    }
+    meterTap.measure (MeterFrame::output, buffer);
+    meterTap.endChunk (buffer.getNumSamples());
+}
+
+template <typename SampleType>
+bool LogicTailAudioProcessor::shouldRunConcurrently (const EngineSet<SampleType>& engines, int numSamples)
+{
+    // A sleeping engine costs next to nothing, so there is nothing to overlap
+    if (engines.delay.isSleeping() || engines.reverb.isSleeping())
+        return false;
+
+    if (numSamples < (isNonRealtime() ? kMinConcurrentSamplesOffline : kMinConcurrentSamplesRealtime))
+        return false;
+
+    // The worker thread is started by the timer the first time it is wanted; until then
+    // the engines run one after the other
+    if (! parallelWorker.isAvailable())
+    {
+        parallelWorker.requestStart();
+        return false;
     }
 
-    // Apply output gain
-    buffer.applyGain(outGain);
+    return true;
 }
 
 juce::AudioProcessorEditor* LogicTailAudioProcessor::createEditor()
@@ -178,14 +627,168 @@ juce::AudioProcessorEditor* LogicTailAudioProcessor::createEditor()
 
 void LogicTailAudioProcessor::getStateInformation (juce::MemoryBlock& destData)
 {
-    auto state = apvts.copyState();
-    std::unique_ptr<juce::XmlElement> xml (state.createXml());
-    copyXmlToBinary (*xml, destData);
+    StateSerializer::write (apvts, morphSlotValues, destData);
 }
 
 void LogicTailAudioProcessor::setStateInformation (const void* data, int sizeInBytes)
 {
+    // Coefficients are designed and posted before the values are published, so the
+    // audio thread finds them ready when the recalled parameters first reach it
+    StateSerializer::ParameterValues values;
+    StateSerializer::MorphSlotValues slots;
+    if (StateSerializer::read (data, sizeInBytes, values, slots))
+    {
+        morphSlotValues = std::move (slots);
+        postMorphSlot (0);
+        postMorphSlot (1);
+
+        publishCoefficients (recalledEqSettings ([this, &values] (const char* id)
+        {
+            return StateSerializer::find (values, id, defaultPlainValue (apvts, id));
+        }));
+
+        StateSerializer::apply (apvts, values);
+        return;
+    }
+
+    // Sessions saved before the binary format: XML ValueTree
     std::unique_ptr<juce::XmlElement> xmlState (getXmlFromBinary (data, sizeInBytes));
     if (xmlState != nullptr && xmlState->hasTagName (apvts.state.getType()))
-        apvts.replaceState (juce::ValueTree::fromXml (*xmlState));
+    {
+        auto state = juce::ValueTree::fromXml (*xmlState);
+
+        // The XML format predates morphing
+        morphSlotValues = {};
+        postMorphSlot (0);
+        postMorphSlot (1);
+
+        publishCoefficients (recalledEqSettings ([this, &state] (const char* id)
+        {
+            auto param = state.getChildWithProperty ("id", id);
+            return param.isValid() ? static_cast<float> (param.getProperty ("value"))
+                                   : defaultPlainValue (apvts, id);
+        }));
+
+        apvts.replaceState (state);
+    }
+}
+
+void LogicTailAudioProcessor::publishCoefficients (const ReverbEqSettings& settings)
+{
+    // Before the first prepareToPlay there is no sample rate to design for; prepare
+    // builds the coefficients itself
+    const double sampleRate = tailSampleRate.load();
+    if (sampleRate <= 0.0)
+        return;
+
+    publishedCoefficients.post (ReverbCoefficientSet::design (sampleRate, settings));
+    publishedSettings = settings;
+    publishedSampleRate = sampleRate;
+}
+
+void LogicTailAudioProcessor::timerCallback()
+{
+    parallelWorker.startIfRequested();
+    publishLoadParameters();
+
+    ParameterSnapshot params;
+    parameterCache.read (params);
+
+    // Before the coefficients: a new tail rate changes the rate they are designed for
+    if (params.tailRate != preparedTailRate)
+        applyTailRate (params.tailRate);
+
+    const auto settings = eqSettingsOf (params);
+    if (! (settings == publishedSettings) || tailSampleRate.load() != publishedSampleRate)
+        publishCoefficients (settings);
+
+    requestSnapshot (params);
+}
+
+void LogicTailAudioProcessor::requestSnapshot (const ParameterSnapshot& params)
+{
+    // Morphing moves the reverb settings on the audio thread, so there is nothing static to capture
+    const auto settings = snapshotSettingsOf (params);
+    if (! params.reverbSnapshot || params.morphEnabled || ! settings.isLinear() || preparedBlockSize == 0)
+    {
+        snapshotSettleTicks = 0;
+        return;
+    }
+
+    if (settings != pendingSnapshotSettings)
+    {
+        pendingSnapshotSettings = settings;
+        snapshotSettleTicks = 0;
+        return;
+    }
+
+    snapshotSettleTicks = juce::jmin (snapshotSettleTicks + 1, kSnapshotSettleTicks);
+
+    if (snapshotSettleTicks < kSnapshotSettleTicks
+        || (snapshotRendered && settings == renderedSnapshotSettings)
+        || snapshotRenderer.getNumJobs() > 0)
+        return;
+
+    renderedSnapshotSettings = settings;
+    snapshotRendered = true;
+
+    // Only the engine set matching the host's precision is prepared
+    const bool doublePrecision = isUsingDoublePrecision();
+    snapshotRenderer.addJob ([this, settings, doublePrecision]
+    {
+        if (doublePrecision)
+            doubleEngines.reverb.captureSnapshot (settings);
+        else
+            floatEngines.reverb.captureSnapshot (settings);
+    });
+}
+
+void LogicTailAudioProcessor::cancelSnapshotRender()
+{
+    snapshotRenderer.removeAllJobs (true, -1);
+    snapshotRendered = false;
+    snapshotSettleTicks = 0;
+}
+
+void LogicTailAudioProcessor::storeMorphSnapshot (int slot)
+{
+    jassert (slot == 0 || slot == 1);
+    morphSlotValues[(size_t) slot] = StateSerializer::capture (apvts);
+    postMorphSlot (slot);
+}
+
+void LogicTailAudioProcessor::postMorphSlot (int slot)
+{
+    const auto& values = morphSlotValues[(size_t) slot];
+
+    MorphSlot morphSlot;
+    morphSlot.stored = ! values.empty();
+
+    if (morphSlot.stored)
+    {
+        morphSlot.parameters = makeParameterSnapshot ([this, &values] (const char* id)
+        {
+            return StateSerializer::find (values, id, defaultPlainValue (apvts, id));
+        });
+
+        // Without a sample rate yet, prepareToPlay designs the coefficients
+        const double sampleRate = tailSampleRate.load();
+        if (sampleRate > 0.0)
+            morphSlot.coefficients = ReverbCoefficientSet::design (sampleRate, eqSettingsOf (morphSlot.parameters));
+    }
+
+    morphSlotMailboxes[slot].post (morphSlot);
+}
+
+void LogicTailAudioProcessor::receiveMorphSlots()
+{
+    for (int i = 0; i < 2; ++i)
+    {
+        morphSlotMailboxes[i].consumeIf ([this, i] (const MorphSlot& slot)
+        {
+            morphSlots[i] = slot;
+            morphCoefficientsDirty = true;
+            return true;
+        });
+    }
 }
@@ -1,9 +1,18 @@
 #pragma once
 #include <JuceHeader.h>
 #include "DSP/DelayEngine.h"
-#include "DSP/ReverbEngine.h"
+#include "DSP/ReverbSection.h"
+#include "DSP/MixStage.h"
+#include "Utility/ParameterSnapshot.h"
+#include "Utility/ParallelWorker.h"
+#include "Utility/SingleSlotMailbox.h"
+#include "Utility/LoadMeter.h"
+#include "Utility/MeterTap.h"
+#include "Utility/SampleTap.h"
+#include "Utility/StateSerializer.h"
 
-class LogicTailAudioProcessor : public juce::AudioProcessor
+class LogicTailAudioProcessor : public juce::AudioProcessor,
+                                private juce::Timer
 {
 public:
     LogicTailAudioProcessor();
@@ -13,6 +22,8 @@ public:
     void releaseResources() override;
     bool isBusesLayoutSupported (const BusesLayout& layouts) const override;
     void processBlock (juce::AudioBuffer<float>&, juce::MidiBuffer&) override;
+    void processBlock (juce::AudioBuffer<double>&, juce::MidiBuffer&) override;
+    bool supportsDoublePrecisionProcessing() const override { return true; }
 
     juce::AudioProcessorEditor* createEditor() override;
     bool hasEditor() const override { return true; }
@@ -21,7 +32,7 @@ public:
     bool acceptsMidi() const override { return false; }
     bool producesMidi() const override { return false; }
     bool isMidiEffect() const override { return false; }
-    double getTailLengthSeconds() const override { return 0.0; }
+    double getTailLengthSeconds() const override { return tailLengthSeconds.load (std::memory_order_relaxed); }
 
     int getNumPrograms() override { return 1; }
     int getCurrentProgram() override { return 0; }
@@ -34,9 +45,155 @@ public:
 
     juce::AudioProcessorValueTreeState& getAPVTS() { return apvts; }
 
+    // Per-stage processing load, readable from any thread
+    LoadMeter& getLoadMeter() noexcept { return loadMeter; }
+
+    // A/B morph snapshots (message thread): stores the current parameter values in
+    // slot 0 (A) or 1 (B). The Morph parameter blends between them while Morph On is set.
+    void storeMorphSnapshot (int slot);
+    bool hasMorphSnapshot (int slot) const { return ! morphSlotValues[(size_t) slot].empty(); }
+
+    // Decimated level / feedback frames for the editor's meters (single consumer)
+    MeterTap& getMeterTap() noexcept { return meterTap; }
+
+    // Reverb output samples for the editor's spectrum / decay analyzer (single consumer)
+    SampleTap& getReverbTap() noexcept { return reverbTap; }
+
 private:
+    // Engines and scratch buffers for one processing precision
+    template <typename SampleType>
+    struct EngineSet
+    {
+        DelayEngine<SampleType> delay;
+        ReverbSection<SampleType> reverb;
+
+        // Scratch buffers sized in prepareToPlay — never resized on the audio thread
+        juce::AudioBuffer<SampleType> dryBuffer;
+        juce::AudioBuffer<SampleType> reverbBuffer;
+    };
+
+    template <typename SampleType>
+    void prepareEngines (EngineSet<SampleType>& engines, double sampleRate);
+
+    // Prepares the reverb for preparedTailRate (allocates)
+    template <typename SampleType>
+    void prepareReverb (EngineSet<SampleType>& engines, double sampleRate);
+
+    // Message thread: re-prepares the reverb at the rate a new Tail Rate setting gives,
+    // with processing suspended, if that rate differs from the current one
+    void applyTailRate (int tailRate);
+
+    template <typename SampleType>
+    void processBlockInternal (juce::AudioBuffer<SampleType>& buffer, EngineSet<SampleType>& engines);
+
+    // Forwards only the parameters that changed since the previous block to the engines
+    template <typename SampleType>
+    void applyParameterChanges (EngineSet<SampleType>& engines, const ParameterSnapshot& params, double bpm);
+
+    // One morph control tick: advances the smoothed morph position and applies the
+    // blended A/B snapshot. Allocation-free, so it runs inside the chunk loop.
+    template <typename SampleType>
+    void applyMorphTick (EngineSet<SampleType>& engines, const ParameterSnapshot& live, double bpm, int numSamples);
+
+    // Re-estimates the tail from both engines and the routing mode
+    template <typename SampleType>
+    void updateTailLength (const EngineSet<SampleType>& engines, int routingIdx, float balance);
+
+    // Cost heuristic for running the two Parallel-routing engines on separate threads;
+    // asks for the worker thread when overlap is worth it but none is running yet
+    template <typename SampleType>
+    bool shouldRunConcurrently (const EngineSet<SampleType>& engines, int numSamples);
+
+    // Runs routing + mix on a slice no longer than the prepared block size
+    template <typename SampleType>
+    void processChunk (juce::AudioBuffer<SampleType>& buffer, EngineSet<SampleType>& engines, int routingIdx);
+
+    // Message thread: periodically mirrors the load meter into the meter parameters. The
+    // audio thread only closes each block's measurement, which LoadMeter keeps in atomics.
+    void publishLoadParameters();
+
+    // Designs the reverb coefficients for `settings` off the audio thread and posts them
+    void publishCoefficients (const ReverbEqSettings& settings);
+
+    // Message thread: republishes the reverb coefficients whenever the live EQ settings
+    // or the sample rate have moved since the last set, and refreshes the load parameters
+    void timerCallback() override;
+
+    // Message thread: once the reverb settings have held still with IR Snapshot on, renders
+    // their impulse response on snapshotRenderer for the reverb to convolve with
+    void requestSnapshot (const ParameterSnapshot& params);
+
+    // Stops a render in progress and forgets what was rendered (before re-preparing the reverb)
+    void cancelSnapshotRender();
+
+    // Designs the received morph slots' coefficients for the tail rate (processing stopped)
+    void redesignMorphSlots();
+
+    // Hands a morph slot (with its reverb coefficients designed) to the audio thread
+    void postMorphSlot (int slot);
+    // Audio thread (and prepareToPlay): picks up slots posted by postMorphSlot()
+    void receiveMorphSlots();
+
     juce::AudioProcessorValueTreeState apvts;
-    DelayEngine delayEngine;
-    ReverbEngine reverbEngine;
+    ParameterCache parameterCache;
+    ParameterSnapshot appliedParameters;
+    double appliedBpm = 0.0;
+    bool needsFullParameterUpdate = true;
+
+    // Written on the audio thread when tail-related parameters change, read by the host
+    std::atomic<double> tailLengthSeconds { 0.0 };
+
+    // Only the set matching the host's processing precision is prepared
+    EngineSet<float> floatEngines;
+    EngineSet<double> doubleEngines;
+    MixStage mixStage;
+    ParallelWorker parallelWorker;
+
+    // Renders impulse response snapshots in the background. Declared after the engine
+    // sets so it is destroyed, and its job stopped, before them.
+    juce::ThreadPool snapshotRenderer { 1 };
+    ReverbSnapshotSettings pendingSnapshotSettings;     // Message thread
+    ReverbSnapshotSettings renderedSnapshotSettings;
+    bool snapshotRendered = false;
+    int snapshotSettleTicks = 0;
+
+    LoadMeter loadMeter;
+    MeterTap meterTap;
+    SampleTap reverbTap;
+
+    struct LoadParameters
+    {
+        juce::RangedAudioParameter* average = nullptr;
+        juce::RangedAudioParameter* peak = nullptr;
+    };
+
+    LoadParameters loadParameters[LoadMeter::numStages];
+    int loadPublishTicks = 0;                           // Message thread
+
+    // Reverb coefficients designed on the message thread (live parameter changes and
+    // recalled states), installed by applyParameterChanges() as a plain copy
+    SingleSlotMailbox<ReverbCoefficientSet> publishedCoefficients;
+    ReverbEqSettings publishedSettings;                 // Message thread
+    double publishedSampleRate = 0.0;
+
+    // Rate the reverb engines run at (the host rate decimated per Tail Rate), which every
+    // coefficient set is designed for. Changed only while processing is stopped.
+    std::atomic<double> tailSampleRate { 0.0 };
+    int preparedTailRate = 0;                           // Message thread
+
+    struct MorphSlot
+    {
+        bool stored = false;
+        ParameterSnapshot parameters;
+        ReverbCoefficientSet coefficients;
+    };
+
+    StateSerializer::MorphSlotValues morphSlotValues;   // Message thread, saved with the state
+    SingleSlotMailbox<MorphSlot> morphSlotMailboxes[2];
+    MorphSlot morphSlots[2];                            // Audio thread copies
+    float morphPosition = 0.0f;                         // Smoothed, 0 = A, 1 = B
+    bool morphActive = false;
+    bool morphCoefficientsDirty = true;
+    int preparedBlockSize = 0;
     JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR (LogicTailAudioProcessor)
 };
@@ -0,0 +1,123 @@
+#include "LevelMeters.h"
+
+namespace
+{
+    constexpr float kMinDb = -60.0f;
+    constexpr float kMaxDb = 6.0f;
+    constexpr float kReleaseDbPerSecond = 20.0f;
+
+    // Feedback loop level at which the tail is at risk of running away
+    constexpr float kFeedbackWarning = 1.0f;
+
+    const char* const pointNames[MeterFrame::numPoints] = { "In", "Delay", "Reverb", "Out" };
+
+    float levelToProportion (float gain)
+    {
+        const float dB = juce::Decibels::gainToDecibels (gain, kMinDb);
+        return juce::jlimit (0.0f, 1.0f, (dB - kMinDb) / (kMaxDb - kMinDb));
+    }
+
+    // Meters rise instantly and fall at a fixed dB rate; returns true if the value moved
+    bool applyBallistics (float& shown, float incoming, float releaseGain)
+    {
+        const float next = juce::jmax (incoming, shown * releaseGain);
+        const bool moved = std::abs (next - shown) > 1.0e-6f;
+        shown = next;
+        return moved;
+    }
+
+    void drawBar (juce::Graphics& g, juce::Rectangle<float> area, float rms, float peak, juce::Colour colour)
+    {
+        g.setColour (juce::Colours::darkgrey);
+        g.fillRect (area);
+
+        g.setColour (colour);
+        g.fillRect (area.withWidth (area.getWidth() * levelToProportion (rms)));
+
+        const float peakX = area.getX() + area.getWidth() * levelToProportion (peak);
+        g.setColour (juce::Colours::white);
+        g.fillRect (juce::Rectangle<float> (peakX - 1.0f, area.getY(), 2.0f, area.getHeight()));
+    }
+}
+
+LevelMeters::LevelMeters (MeterTap& tap)
+    : meterTap (tap)
+{
+    meterTap.setActive (true);
+}
+
+LevelMeters::~LevelMeters()
+{
+    meterTap.setActive (false);
+}
+
+void LevelMeters::refresh()
+{
+    const double nowMs = juce::Time::getMillisecondCounterHiRes();
+    const double elapsedSeconds = lastRefreshMs > 0.0 ? (nowMs - lastRefreshMs) / 1000.0 : 0.0;
+    lastRefreshMs = nowMs;
+
+    // Everything published since the last refresh: loudest peak, latest RMS
+    MeterFrame incoming;
+    MeterFrame frame;
+    while (meterTap.pop (frame))
+    {
+        for (int point = 0; point < MeterFrame::numPoints; ++point)
+        {
+            for (int ch = 0; ch < MeterFrame::kNumChannels; ++ch)
+            {
+                incoming.peak[point][ch] = juce::jmax (incoming.peak[point][ch], frame.peak[point][ch]);
+                incoming.rms[point][ch] = frame.rms[point][ch];
+            }
+        }
+
+        for (int ch = 0; ch < MeterFrame::kNumChannels; ++ch)
+            incoming.feedback[ch] = juce::jmax (incoming.feedback[ch], frame.feedback[ch]);
+    }
+
+    const auto releaseGain = juce::Decibels::decibelsToGain (-kReleaseDbPerSecond * static_cast<float> (elapsedSeconds));
+    bool changed = false;
+
+    for (int point = 0; point < MeterFrame::numPoints; ++point)
+    {
+        for (int ch = 0; ch < MeterFrame::kNumChannels; ++ch)
+        {
+            changed |= applyBallistics (levels.peak[point][ch], incoming.peak[point][ch], releaseGain);
+            changed |= applyBallistics (levels.rms[point][ch], incoming.rms[point][ch], releaseGain);
+        }
+    }
+
+    for (int ch = 0; ch < MeterFrame::kNumChannels; ++ch)
+        changed |= applyBallistics (levels.feedback[ch], incoming.feedback[ch], releaseGain);
+
+    if (changed)
+        repaint();
+}
+
+void LevelMeters::paint (juce::Graphics& g)
+{
+    auto area = getLocalBounds().toFloat();
+    const float rowHeight = area.getHeight() / static_cast<float> (MeterFrame::numPoints + 1);
+    const float labelWidth = 56.0f;
+
+    g.setFont (12.0f);
+
+    auto drawRow = [&] (const juce::String& name, const float* rms, const float* peak, juce::Colour colour)
+    {
+        auto row = area.removeFromTop (rowHeight).reduced (0.0f, 3.0f);
+
+        g.setColour (juce::Colours::lightgrey);
+        g.drawText (name, row.removeFromLeft (labelWidth), juce::Justification::centredLeft);
+
+        const float barHeight = row.getHeight() / 2.0f;
+        drawBar (g, row.removeFromTop (barHeight).reduced (0.0f, 1.0f), rms[0], peak[0], colour);
+        drawBar (g, row.reduced (0.0f, 1.0f), rms[1], peak[1], colour);
+    };
+
+    for (int point = 0; point < MeterFrame::numPoints; ++point)
+        drawRow (pointNames[point], levels.rms[point], levels.peak[point], juce::Colours::limegreen);
+
+    // Feedback loop magnitude: a single peak reading, red once the loop nears runaway
+    const bool hot = juce::jmax (levels.feedback[0], levels.feedback[1]) >= kFeedbackWarning;
+    drawRow ("Fdbk", levels.feedback, levels.feedback, hot ? juce::Colours::red : juce::Colours::orange);
+}
@@ -0,0 +1,29 @@
+#pragma once
+#include <JuceHeader.h>
+#include "../Utility/MeterTap.h"
+
+// Peak / RMS meters for input, both engines and output, plus the reverb feedback level.
+//
+// Frames are drained from the processor's MeterTap on every display refresh through a
+// VBlankAttachment, so updates are capped at the screen rate and stop while the editor
+// is hidden. The tap only measures while this component exists. Nothing here touches
+// the APVTS.
+class LevelMeters : public juce::Component
+{
+public:
+    explicit LevelMeters (MeterTap& tap);
+    ~LevelMeters() override;
+
+    void paint (juce::Graphics&) override;
+
+private:
+    void refresh();
+
+    MeterTap& meterTap;
+    MeterFrame levels;              // Displayed (linear) levels after release ballistics
+    double lastRefreshMs = 0.0;
+
+    juce::VBlankAttachment vBlank { this, [this] { refresh(); } };
+
+    JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR (LevelMeters)
+};
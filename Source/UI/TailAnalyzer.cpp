@@ -0,0 +1,190 @@
+#include "TailAnalyzer.h"
+
+namespace
+{
+    constexpr float kFloorDb = -120.0f;
+    constexpr float kSpectrumFallDbPerFrame = 1.5f;
+
+    // Decay estimates need a clear, steady fall well above the floor
+    constexpr float kMinDecayDbPerSecond = 3.0f;
+    constexpr float kMinDecayRangeDb = 6.0f;
+    constexpr float kMinDecayLevelDb = -90.0f;
+    constexpr float kDecaySmoothing = 0.3f;
+
+    float spectrumPointHz (int point)
+    {
+        const float proportion = static_cast<float> (point) / (TailAnalysisFrame::kNumSpectrumPoints - 1);
+        return 20.0f * std::pow (1000.0f, proportion);
+    }
+}
+
+TailAnalyzer::TailAnalyzer (SampleTap& tap)
+    : juce::Thread ("LogicTail analyzer"), sampleTap (tap)
+{
+    history.assign (static_cast<size_t> (kFftSize), 0.0f);
+    readBuffer.assign (static_cast<size_t> (kFftSize), 0.0f);
+    fftData.assign (static_cast<size_t> (2 * kFftSize), 0.0f);
+
+    for (auto& point : frame.spectrumDb)
+        point = kFloorDb;
+}
+
+TailAnalyzer::~TailAnalyzer()
+{
+    stop();
+}
+
+void TailAnalyzer::start()
+{
+    sampleTap.setActive (true);
+    startThread (juce::Thread::Priority::low);
+}
+
+void TailAnalyzer::stop()
+{
+    stopThread (1000);
+    sampleTap.setActive (false);
+}
+
+bool TailAnalyzer::getLatestFrame (TailAnalysisFrame& dest) noexcept
+{
+    return published.consumeIf ([&dest] (const TailAnalysisFrame& latest)
+    {
+        dest = latest;
+        return true;
+    });
+}
+
+float TailAnalyzer::bandCentreHz (int band) noexcept
+{
+    return 62.5f * static_cast<float> (1 << band);
+}
+
+void TailAnalyzer::run()
+{
+    const double frameMs = 1000.0 / kFramesPerSecond;
+
+    while (! threadShouldExit())
+    {
+        const double frameStart = juce::Time::getMillisecondCounterHiRes();
+
+        pullSamples();
+        analyse (sampleTap.getSampleRate());
+        published.post (frame);
+
+        const double elapsed = juce::Time::getMillisecondCounterHiRes() - frameStart;
+        wait (juce::jmax (1, static_cast<int> (frameMs - elapsed)));
+    }
+}
+
+void TailAnalyzer::pullSamples()
+{
+    // Only the newest kFftSize samples matter; older ones are overwritten in place
+    for (;;)
+    {
+        const int numRead = sampleTap.read (readBuffer.data(), kFftSize);
+        for (int i = 0; i < numRead; ++i)
+        {
+            history[static_cast<size_t> (historyPos)] = readBuffer[static_cast<size_t> (i)];
+            historyPos = (historyPos + 1) & (kFftSize - 1);
+        }
+
+        if (numRead < kFftSize)
+            break;
+    }
+}
+
+void TailAnalyzer::analyse (double sampleRate)
+{
+    // Oldest sample first, then window and transform
+    for (int i = 0; i < kFftSize; ++i)
+        fftData[static_cast<size_t> (i)] = history[static_cast<size_t> ((historyPos + i) & (kFftSize - 1))];
+
+    std::fill (fftData.begin() + kFftSize, fftData.end(), 0.0f);
+    window.multiplyWithWindowingTable (fftData.data(), static_cast<size_t> (kFftSize));
+    fft.performFrequencyOnlyForwardTransform (fftData.data());
+
+    updateSpectrum (sampleRate);
+    updateDecay (sampleRate);
+}
+
+void TailAnalyzer::updateSpectrum (double sampleRate)
+{
+    // Amplitude normalisation for a Hann-windowed real FFT (full-scale sine ≈ 0 dB)
+    const float scale = 4.0f / kFftSize;
+    const float binsPerHz = static_cast<float> (kFftSize / sampleRate);
+
+    for (int point = 0; point < TailAnalysisFrame::kNumSpectrumPoints; ++point)
+    {
+        const float bin = juce::jlimit (0.0f, kFftSize / 2.0f - 1.0f, spectrumPointHz (point) * binsPerHz);
+        const int index = static_cast<int> (bin);
+        const float frac = bin - static_cast<float> (index);
+        const float magnitude = fftData[static_cast<size_t> (index)]
+                              + frac * (fftData[static_cast<size_t> (index + 1)] - fftData[static_cast<size_t> (index)]);
+
+        // Rises immediately, falls at a fixed rate per frame
+        const float dB = juce::Decibels::gainToDecibels (magnitude * scale, kFloorDb);
+        frame.spectrumDb[point] = juce::jmax (dB, frame.spectrumDb[point] - kSpectrumFallDbPerFrame);
+    }
+}
+
+void TailAnalyzer::updateDecay (double sampleRate)
+{
+    const float binsPerHz = static_cast<float> (kFftSize / sampleRate);
+    const float scale = 4.0f / kFftSize;
+
+    for (int band = 0; band < TailAnalysisFrame::kNumBands; ++band)
+    {
+        // Octave band energy from the FFT bins it covers
+        const float centre = bandCentreHz (band);
+        const int firstBin = juce::jmax (1, static_cast<int> (centre / juce::MathConstants<float>::sqrt2 * binsPerHz));
+        const int lastBin  = juce::jlimit (firstBin + 1, kFftSize / 2, static_cast<int> (centre * juce::MathConstants<float>::sqrt2 * binsPerHz));
+
+        float energy = 0.0f;
+        for (int bin = firstBin; bin < lastBin; ++bin)
+        {
+            const float magnitude = fftData[static_cast<size_t> (bin)] * scale;
+            energy += magnitude * magnitude;
+        }
+
+        auto& levels = bandLevelsDb[band];
+        std::move (levels + 1, levels + kDecayFrames, levels);
+        levels[kDecayFrames - 1] = juce::jmax (kFloorDb, 10.0f * std::log10 (energy + 1.0e-12f));
+    }
+
+    numBandFrames = juce::jmin (numBandFrames + 1, kDecayFrames);
+    if (numBandFrames < kDecayFrames)
+        return;
+
+    // Least-squares slope of the band level over the regression window, in dB per second
+    constexpr float meanX = (kDecayFrames - 1) / 2.0f;
+    float sumXX = 0.0f;
+    for (int i = 0; i < kDecayFrames; ++i)
+        sumXX += (i - meanX) * (i - meanX);
+
+    for (int band = 0; band < TailAnalysisFrame::kNumBands; ++band)
+    {
+        const auto& levels = bandLevelsDb[band];
+
+        float meanY = 0.0f;
+        for (float level : levels)
+            meanY += level;
+        meanY /= kDecayFrames;
+
+        float sumXY = 0.0f;
+        for (int i = 0; i < kDecayFrames; ++i)
+            sumXY += (i - meanX) * (levels[i] - meanY);
+
+        const float dBPerSecond = sumXY / sumXX * kFramesPerSecond;
+        const bool decaying = dBPerSecond <= -kMinDecayDbPerSecond
+                           && levels[0] - levels[kDecayFrames - 1] >= kMinDecayRangeDb
+                           && levels[kDecayFrames - 1] >= kMinDecayLevelDb;
+
+        if (! decaying)
+            continue;
+
+        const float rt60 = juce::jlimit (0.05f, 60.0f, -60.0f / dBPerSecond);
+        auto& estimate = frame.decaySeconds[band];
+        estimate = estimate > 0.0f ? estimate + kDecaySmoothing * (rt60 - estimate) : rt60;
+    }
+}
@@ -0,0 +1,66 @@
+#pragma once
+#include <JuceHeader.h>
+#include "../Utility/SampleTap.h"
+#include "../Utility/SingleSlotMailbox.h"
+
+// One analysis result: a smoothed log-frequency spectrum and per-octave decay times
+struct TailAnalysisFrame
+{
+    static constexpr int kNumSpectrumPoints = 128;   // Log-spaced, 20 Hz – 20 kHz
+    static constexpr int kNumBands = 8;              // Octave bands, 63 Hz – 8 kHz
+
+    float spectrumDb[kNumSpectrumPoints] {};
+    float decaySeconds[kNumBands] {};                // RT60 estimate, 0 until measured
+};
+
+// Background spectrum / decay analysis of the reverb output.
+//
+// Owns one thread that wakes at a fixed frame rate, drains the processor's SampleTap,
+// runs a single FFT and updates the octave-band decay estimates — a bounded amount of
+// work per frame no matter how much audio arrived. Results are handed to the GUI
+// through a SingleSlotMailbox. The tap is only active while the thread runs.
+class TailAnalyzer : private juce::Thread
+{
+public:
+    explicit TailAnalyzer (SampleTap& tap);
+    ~TailAnalyzer() override;
+
+    void start();
+    void stop();
+
+    // GUI thread: copies the newest frame into `dest`, returns false if nothing new
+    bool getLatestFrame (TailAnalysisFrame& dest) noexcept;
+
+    static float bandCentreHz (int band) noexcept;
+
+private:
+    void run() override;
+    void pullSamples();
+    void analyse (double sampleRate);
+    void updateSpectrum (double sampleRate);
+    void updateDecay (double sampleRate);
+
+    static constexpr int kFftOrder = 11;
+    static constexpr int kFftSize = 1 << kFftOrder;
+    static constexpr int kFramesPerSecond = 30;
+    static constexpr int kDecayFrames = 12;          // Regression window (~0.4 s)
+
+    SampleTap& sampleTap;
+
+    juce::dsp::FFT fft { kFftOrder };
+    juce::dsp::WindowingFunction<float> window { static_cast<size_t> (kFftSize),
+                                                 juce::dsp::WindowingFunction<float>::hann, false };
+
+    std::vector<float> history;                      // Last kFftSize samples, circular
+    int historyPos = 0;
+    std::vector<float> readBuffer;
+    std::vector<float> fftData;
+
+    float bandLevelsDb[TailAnalysisFrame::kNumBands][kDecayFrames] {};
+    int numBandFrames = 0;
+
+    TailAnalysisFrame frame;
+    SingleSlotMailbox<TailAnalysisFrame> published;
+
+    JUCE_DECLARE_NON_COPYABLE (TailAnalyzer)
+};
@@ -0,0 +1,83 @@
+#include "TailVisualizer.h"
+
+namespace
+{
+    constexpr float kMinDb = -90.0f;
+    constexpr float kMaxDb = 0.0f;
+    constexpr float kMaxDecaySeconds = 10.0f;
+    constexpr float kLabelHeight = 14.0f;
+
+    juce::String bandLabel (float hz)
+    {
+        return hz >= 1000.0f ? juce::String (hz / 1000.0f, 0) + "k" : juce::String (juce::roundToInt (hz));
+    }
+}
+
+TailVisualizer::TailVisualizer (SampleTap& tap)
+    : analyzer (tap)
+{
+    for (auto& point : frame.spectrumDb)
+        point = kMinDb;
+
+    analyzer.start();
+}
+
+TailVisualizer::~TailVisualizer()
+{
+    analyzer.stop();
+}
+
+void TailVisualizer::refresh()
+{
+    if (analyzer.getLatestFrame (frame))
+        repaint();
+}
+
+void TailVisualizer::paint (juce::Graphics& g)
+{
+    auto area = getLocalBounds().toFloat();
+    g.setColour (juce::Colours::darkgrey.darker (0.6f));
+    g.fillRect (area);
+
+    // Upper part: spectrum, 20 Hz – 20 kHz on a log axis
+    auto spectrumArea = area.removeFromTop (area.getHeight() * 0.6f).reduced (4.0f);
+    juce::Path spectrum;
+
+    for (int point = 0; point < TailAnalysisFrame::kNumSpectrumPoints; ++point)
+    {
+        const float x = spectrumArea.getX() + spectrumArea.getWidth() * point / (TailAnalysisFrame::kNumSpectrumPoints - 1);
+        const float level = juce::jlimit (0.0f, 1.0f, (frame.spectrumDb[point] - kMinDb) / (kMaxDb - kMinDb));
+        const float y = spectrumArea.getBottom() - spectrumArea.getHeight() * level;
+
+        if (point == 0)
+            spectrum.startNewSubPath (x, y);
+        else
+            spectrum.lineTo (x, y);
+    }
+
+    g.setColour (juce::Colours::cyan);
+    g.strokePath (spectrum, juce::PathStrokeType (1.5f));
+
+    // Lower part: RT60 estimate per octave band
+    auto decayArea = area.reduced (4.0f);
+    const float barWidth = decayArea.getWidth() / TailAnalysisFrame::kNumBands;
+    g.setFont (10.0f);
+
+    for (int band = 0; band < TailAnalysisFrame::kNumBands; ++band)
+    {
+        auto column = decayArea.removeFromLeft (barWidth).reduced (2.0f, 0.0f);
+        auto label = column.removeFromBottom (kLabelHeight);
+        auto value = column.removeFromTop (kLabelHeight);
+
+        const float seconds = frame.decaySeconds[band];
+        const float proportion = juce::jlimit (0.0f, 1.0f, seconds / kMaxDecaySeconds);
+
+        g.setColour (juce::Colours::orange);
+        g.fillRect (column.removeFromBottom (column.getHeight() * proportion));
+
+        g.setColour (juce::Colours::lightgrey);
+        g.drawText (bandLabel (TailAnalyzer::bandCentreHz (band)), label, juce::Justification::centred);
+        if (seconds > 0.0f)
+            g.drawText (juce::String (seconds, 1) + "s", value, juce::Justification::centred);
+    }
+}
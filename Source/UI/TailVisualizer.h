@@ -0,0 +1,26 @@
+#pragma once
+#include <JuceHeader.h>
+#include "TailAnalyzer.h"
+
+// Spectrum and per-octave decay-time display of the reverb output.
+//
+// The analysis runs on the TailAnalyzer thread, which lives exactly as long as this
+// component (and therefore the editor). Painting picks up new frames on vblank.
+class TailVisualizer : public juce::Component
+{
+public:
+    explicit TailVisualizer (SampleTap& tap);
+    ~TailVisualizer() override;
+
+    void paint (juce::Graphics&) override;
+
+private:
+    void refresh();
+
+    TailAnalyzer analyzer;
+    TailAnalysisFrame frame;
+
+    juce::VBlankAttachment vBlank { this, [this] { refresh(); } };
+
+    JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR (TailVisualizer)
+};
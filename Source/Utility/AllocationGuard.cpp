@@ -0,0 +1,92 @@
+#include "AllocationGuard.h"
+#include <cstdlib>
+#include <new>
+
+#if JUCE_DEBUG && JUCE_WINDOWS
+ #include <malloc.h>
+#endif
+
+#if JUCE_DEBUG
+namespace
+{
+    thread_local int guardDepth = 0;
+
+    // jassert may log (and therefore allocate) — suppress re-entry while reporting
+    thread_local bool isReporting = false;
+
+    void checkAllocationAllowed() noexcept
+    {
+        if (guardDepth > 0 && ! isReporting)
+        {
+            isReporting = true;
+            jassertfalse;   // Heap allocation inside processBlock — see call stack
+            isReporting = false;
+        }
+    }
+
+    void* guardedAlloc (std::size_t size)
+    {
+        checkAllocationAllowed();
+
+        if (auto* ptr = std::malloc (size > 0 ? size : 1))
+            return ptr;
+
+        throw std::bad_alloc();
+    }
+
+    // Over-aligned types (alignas beyond the default new alignment) come through here
+    void* guardedAlignedAlloc (std::size_t size, std::align_val_t alignment)
+    {
+        checkAllocationAllowed();
+
+        const auto align = juce::jmax (static_cast<std::size_t> (alignment), sizeof (void*));
+        if (size == 0)
+            size = 1;
+
+       #if JUCE_WINDOWS
+        if (auto* ptr = _aligned_malloc (size, align))
+            return ptr;
+       #else
+        void* ptr = nullptr;
+        if (posix_memalign (&ptr, align, size) == 0)
+            return ptr;
+       #endif
+
+        throw std::bad_alloc();
+    }
+
+    void alignedFree (void* ptr) noexcept
+    {
+       #if JUCE_WINDOWS
+        _aligned_free (ptr);
+       #else
+        std::free (ptr);
+       #endif
+    }
+}
+
+ScopedAllocationGuard::ScopedAllocationGuard() noexcept   { ++guardDepth; }
+ScopedAllocationGuard::~ScopedAllocationGuard() noexcept  { --guardDepth; }
+bool ScopedAllocationGuard::isActiveOnThisThread() noexcept { return guardDepth > 0; }
+
+// Replacement global allocation functions (debug builds only), plain and aligned. The
+// nothrow overloads forward to these per the standard.
+void* operator new (std::size_t size)                  { return guardedAlloc (size); }
+void* operator new[] (std::size_t size)                { return guardedAlloc (size); }
+void  operator delete (void* ptr) noexcept             { std::free (ptr); }
+void  operator delete[] (void* ptr) noexcept           { std::free (ptr); }
+void  operator delete (void* ptr, std::size_t) noexcept   { std::free (ptr); }
+void  operator delete[] (void* ptr, std::size_t) noexcept { std::free (ptr); }
+
+void* operator new (std::size_t size, std::align_val_t alignment)   { return guardedAlignedAlloc (size, alignment); }
+void* operator new[] (std::size_t size, std::align_val_t alignment) { return guardedAlignedAlloc (size, alignment); }
+void  operator delete (void* ptr, std::align_val_t) noexcept                 { alignedFree (ptr); }
+void  operator delete[] (void* ptr, std::align_val_t) noexcept               { alignedFree (ptr); }
+void  operator delete (void* ptr, std::size_t, std::align_val_t) noexcept    { alignedFree (ptr); }
+void  operator delete[] (void* ptr, std::size_t, std::align_val_t) noexcept  { alignedFree (ptr); }
+
+#else
+ScopedAllocationGuard::ScopedAllocationGuard() noexcept = default;
+ScopedAllocationGuard::~ScopedAllocationGuard() noexcept = default;
+bool ScopedAllocationGuard::isActiveOnThisThread() noexcept { return false; }
+#endif
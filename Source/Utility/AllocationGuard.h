@@ -0,0 +1,22 @@
+#pragma once
+#include <JuceHeader.h>
+
+// Debug-only detector for heap allocations on the audio thread.
+//
+// While a ScopedAllocationGuard is alive on the current thread, any call to the
+// global operator new/new[] (plain or aligned) hits jassertfalse. Only operator new
+// is hooked: std::malloc/realloc and anything built on them, such as juce::HeapBlock,
+// go unnoticed. In release builds the guard is an empty object and operator new is
+// left untouched.
+class ScopedAllocationGuard
+{
+public:
+    ScopedAllocationGuard() noexcept;
+    ~ScopedAllocationGuard() noexcept;
+
+    // True while at least one guard is alive on the calling thread
+    static bool isActiveOnThisThread() noexcept;
+
+private:
+    JUCE_DECLARE_NON_COPYABLE (ScopedAllocationGuard)
+};
@@ -0,0 +1,40 @@
+#include "LoadMeter.h"
+
+void LoadMeter::prepare (double newSampleRate)
+{
+    sampleRate = newSampleRate;
+    secondsPerTick = 1.0 / static_cast<double> (juce::Time::getHighResolutionTicksPerSecond());
+
+    for (int i = 0; i < numStages; ++i)
+    {
+        ticksThisBlock[i] = 0;
+        averageState[i] = 0.0f;
+        peakState[i] = 0.0f;
+        average[i].store (0.0f, std::memory_order_relaxed);
+        peak[i].store (0.0f, std::memory_order_relaxed);
+    }
+}
+
+void LoadMeter::endBlock (int numSamples) noexcept
+{
+    if (numSamples <= 0)
+        return;
+
+    const double blockSeconds = numSamples / sampleRate;
+
+    // One-pole average with a fixed time constant, whatever the block size
+    const auto smoothing = static_cast<float> (1.0 - std::exp (-blockSeconds / kAverageSeconds));
+    const bool resetPeaks = peakResetRequested.exchange (false, std::memory_order_relaxed);
+
+    for (int i = 0; i < numStages; ++i)
+    {
+        const auto load = static_cast<float> (ticksThisBlock[i] * secondsPerTick / blockSeconds);
+        ticksThisBlock[i] = 0;
+
+        averageState[i] += smoothing * (load - averageState[i]);
+        peakState[i] = resetPeaks ? load : juce::jmax (peakState[i], load);
+
+        average[i].store (averageState[i], std::memory_order_relaxed);
+        peak[i].store (peakState[i], std::memory_order_relaxed);
+    }
+}
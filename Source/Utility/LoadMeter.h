@@ -0,0 +1,61 @@
+#pragma once
+#include <JuceHeader.h>
+
+// Measures how much of each block's real-time deadline the processing stages use.
+//
+// While a block runs, the stages accumulate high-resolution ticks; endBlock() turns
+// them into loads (1.0 = the whole block duration) and publishes a rolling average
+// and a held peak per stage through relaxed atomics. Readers on any thread never
+// block or contend with the audio thread.
+//
+// `total` is the wall time of the whole processBlock. When Parallel routing runs the
+// reverb on the worker thread, delay and reverb overlap and may add up to more than it.
+class LoadMeter
+{
+public:
+    enum Stage { delay, reverb, mix, total, numStages };
+
+    // Message thread, before processing starts
+    void prepare (double sampleRate);
+
+    // Audio thread (the reverb stage also from the parallel worker while it owns the
+    // reverb). Each stage accumulator is only ever touched by one thread at a time.
+    void addTicks (Stage stage, juce::int64 ticks) noexcept { ticksThisBlock[stage] += ticks; }
+    void endBlock (int numSamples) noexcept;
+
+    // Any thread
+    float getAverage (Stage stage) const noexcept { return average[stage].load (std::memory_order_relaxed); }
+    float getPeak (Stage stage) const noexcept    { return peak[stage].load (std::memory_order_relaxed); }
+    void resetPeaks() noexcept                    { peakResetRequested.store (true, std::memory_order_relaxed); }
+
+    // Times the enclosing scope into one stage
+    class ScopedStage
+    {
+    public:
+        ScopedStage (LoadMeter& m, Stage s) noexcept
+            : meter (m), stage (s), start (juce::Time::getHighResolutionTicks()) {}
+
+        ~ScopedStage() noexcept { meter.addTicks (stage, juce::Time::getHighResolutionTicks() - start); }
+
+    private:
+        LoadMeter& meter;
+        const Stage stage;
+        const juce::int64 start;
+
+        JUCE_DECLARE_NON_COPYABLE (ScopedStage)
+    };
+
+private:
+    static constexpr double kAverageSeconds = 0.5;   // Time constant of the rolling average
+
+    double sampleRate = 44100.0;
+    double secondsPerTick = 1.0e-6;
+
+    juce::int64 ticksThisBlock[numStages] {};
+    float averageState[numStages] {};
+    float peakState[numStages] {};
+
+    std::atomic<float> average[numStages] {};
+    std::atomic<float> peak[numStages] {};
+    std::atomic<bool> peakResetRequested { false };
+};
@@ -0,0 +1,94 @@
+#include "MeterTap.h"
+
+void MeterTap::prepare (double sampleRate)
+{
+    windowSamples = juce::jmax (1, juce::roundToInt (sampleRate / kFramesPerSecond));
+    resetWindow();
+}
+
+template <typename SampleType>
+void MeterTap::measure (MeterFrame::Point point, const juce::AudioBuffer<SampleType>& buffer) noexcept
+{
+    if (! active.load (std::memory_order_relaxed))
+        return;
+
+    const int numChannels = juce::jmin (buffer.getNumChannels(), MeterFrame::kNumChannels);
+    const int numSamples  = buffer.getNumSamples();
+
+    for (int ch = 0; ch < numChannels; ++ch)
+    {
+        const auto* data = buffer.getReadPointer (ch);
+        float peak = current.peak[point][ch];
+        double sum = 0.0;
+
+        for (int i = 0; i < numSamples; ++i)
+        {
+            const auto x = static_cast<float> (data[i]);
+            peak = juce::jmax (peak, std::abs (x));
+            sum += static_cast<double> (x) * x;
+        }
+
+        current.peak[point][ch] = peak;
+        sumSquares[point][ch] += sum;
+    }
+
+    // Mono layouts show the single channel on both meters
+    if (numChannels == 1)
+    {
+        current.peak[point][1] = current.peak[point][0];
+        sumSquares[point][1] = sumSquares[point][0];
+    }
+}
+
+void MeterTap::measureFeedback (float left, float right) noexcept
+{
+    if (! active.load (std::memory_order_relaxed))
+        return;
+
+    current.feedback[0] = juce::jmax (current.feedback[0], std::abs (left));
+    current.feedback[1] = juce::jmax (current.feedback[1], std::abs (right));
+}
+
+void MeterTap::endChunk (int numSamples) noexcept
+{
+    if (! active.load (std::memory_order_relaxed))
+    {
+        // Drop the partial window so the next consumer starts from fresh levels
+        if (samplesInWindow > 0)
+            resetWindow();
+
+        return;
+    }
+
+    samplesInWindow += numSamples;
+    if (samplesInWindow < windowSamples)
+        return;
+
+    for (int point = 0; point < MeterFrame::numPoints; ++point)
+        for (int ch = 0; ch < MeterFrame::kNumChannels; ++ch)
+            current.rms[point][ch] = static_cast<float> (std::sqrt (sumSquares[point][ch] / samplesInWindow));
+
+    ring.push (current);   // Dropped if the GUI is not keeping up (or closed)
+    resetWindow();
+}
+
+void MeterTap::setActive (bool shouldBeActive) noexcept
+{
+    if (shouldBeActive)
+        ring.discardAll();
+
+    active.store (shouldBeActive, std::memory_order_relaxed);
+}
+
+void MeterTap::resetWindow() noexcept
+{
+    current = {};
+    for (auto& point : sumSquares)
+        for (auto& sum : point)
+            sum = 0.0;
+
+    samplesInWindow = 0;
+}
+
+template void MeterTap::measure<float> (MeterFrame::Point, const juce::AudioBuffer<float>&) noexcept;
+template void MeterTap::measure<double> (MeterFrame::Point, const juce::AudioBuffer<double>&) noexcept;
@@ -0,0 +1,51 @@
+#pragma once
+#include <JuceHeader.h>
+#include "SpscRing.h"
+
+// One decimated metering frame: peak and RMS per channel at each tap point, plus the
+// peak magnitude of the reverb's feedback loop state.
+struct MeterFrame
+{
+    enum Point { input, delay, reverb, output, numPoints };
+    static constexpr int kNumChannels = 2;
+
+    float peak[numPoints][kNumChannels] {};
+    float rms[numPoints][kNumChannels] {};
+    float feedback[kNumChannels] {};
+};
+
+// Audio-thread side of the metering pipeline.
+//
+// The processor calls measure() at each tap point per chunk and endChunk() after it;
+// once a window of ~1/60 s has been collected, the frame is pushed into a wait-free
+// SPSC ring. Nothing here locks or allocates. While inactive (no meters on screen) every
+// call returns immediately, and the GUI drains the ring with pop() while active.
+class MeterTap
+{
+public:
+    // Message thread, before processing starts
+    void prepare (double sampleRate);
+
+    // Audio thread
+    template <typename SampleType>
+    void measure (MeterFrame::Point point, const juce::AudioBuffer<SampleType>& buffer) noexcept;
+    void measureFeedback (float left, float right) noexcept;
+    void endChunk (int numSamples) noexcept;
+
+    // GUI thread (single consumer). Activating drops frames left over from a previous consumer.
+    void setActive (bool shouldBeActive) noexcept;
+    bool pop (MeterFrame& frame) noexcept { return ring.pop (frame); }
+
+private:
+    static constexpr double kFramesPerSecond = 60.0;
+
+    void resetWindow() noexcept;
+
+    std::atomic<bool> active { false };
+    MeterFrame current;
+    double sumSquares[MeterFrame::numPoints][MeterFrame::kNumChannels] {};
+    int samplesInWindow = 0;
+    int windowSamples = 735;
+
+    SpscRing<MeterFrame, 64> ring;   // ~1 s of frames
+};
@@ -0,0 +1,100 @@
+#include "ParallelWorker.h"
+
+namespace
+{
+    // The worker yield-spins this long after the last launch, which spans the gap between
+    // blocks at any usual buffer size, then dozes in timed waits of kIdlePollMs
+    constexpr juce::uint32 kSpinWindowMs = 100;
+    constexpr int kIdlePollMs = 1;
+}
+
+ParallelWorker::ParallelWorker()
+    : juce::Thread ("LogicTail parallel worker")
+{
+}
+
+ParallelWorker::~ParallelWorker()
+{
+    stop();
+}
+
+void ParallelWorker::startIfRequested()
+{
+    if (! startRequested.exchange (false) || isAvailable() || juce::SystemStats::getNumCpus() < 2)
+        return;
+
+    available.store (startThread (juce::Thread::Priority::highest), std::memory_order_release);
+}
+
+void ParallelWorker::stop()
+{
+    startRequested.store (false);
+
+    if (! isAvailable())
+        return;
+
+    available.store (false);
+    signalThreadShouldExit();
+    exitEvent.signal();
+    stopThread (1000);
+}
+
+void ParallelWorker::launch (JobFunction job, void* context) noexcept
+{
+    jassert (state.load (std::memory_order_relaxed) == idle);
+
+    pendingJob = job;
+    pendingContext = context;
+    launchCount.fetch_add (1, std::memory_order_relaxed);
+    state.store (pending, std::memory_order_release);
+}
+
+void ParallelWorker::join() noexcept
+{
+    // Not started yet — take the job back and run it here
+    int expected = pending;
+    if (state.compare_exchange_strong (expected, running, std::memory_order_acquire))
+    {
+        pendingJob (pendingContext);
+        state.store (idle, std::memory_order_relaxed);
+        return;
+    }
+
+    while (state.load (std::memory_order_acquire) != done)
+        juce::Thread::yield();
+
+    state.store (idle, std::memory_order_relaxed);
+}
+
+void ParallelWorker::run()
+{
+    // Engines rely on flush-to-zero just like the audio thread
+    const juce::ScopedNoDenormals noDenormals;
+
+    // Nothing launched yet: doze straight away
+    auto seenLaunches = launchCount.load (std::memory_order_relaxed);
+    auto lastActivity = juce::Time::getMillisecondCounter() - kSpinWindowMs;
+
+    while (! threadShouldExit())
+    {
+        int expected = pending;
+        if (state.compare_exchange_strong (expected, running, std::memory_order_acquire))
+        {
+            pendingJob (pendingContext);
+            state.store (done, std::memory_order_release);
+        }
+
+        const auto now = juce::Time::getMillisecondCounter();
+        const auto launches = launchCount.load (std::memory_order_relaxed);
+        if (launches != seenLaunches)
+        {
+            seenLaunches = launches;
+            lastActivity = now;
+        }
+
+        if (now - lastActivity < kSpinWindowMs)
+            juce::Thread::yield();
+        else
+            exitEvent.wait (kIdlePollMs);
+    }
+}
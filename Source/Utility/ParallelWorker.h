@@ -0,0 +1,63 @@
+#pragma once
+#include <JuceHeader.h>
+
+// A single preallocated helper thread that runs one job alongside the audio thread.
+//
+// launch() publishes the job with one atomic store; join() waits for it. If the worker
+// has not picked the job up by the time join() is called, the caller takes it back and
+// runs it itself, so a sleeping or descheduled worker can never stall the audio thread
+// for longer than the job itself would have taken.
+//
+// The thread is only started once the audio thread asks for it (requestStart()), so an
+// instance that never dispatches a job never owns one.
+//
+// launch() never takes a lock or makes a system call: the worker is never woken, it polls.
+// That cost lands on the worker instead. For 100 ms after the last launch it yield-spins,
+// so a core shows as fully busy for as long as the processor keeps dispatching (it still
+// gives way to any other runnable thread). After that it dozes in 1 ms timed waits, about
+// a thousand wake-ups a second until stop(). A job launched while it dozes is normally
+// taken back by join(), and the worker, seeing that a launch happened, spins again in time
+// for the next one.
+class ParallelWorker : private juce::Thread
+{
+public:
+    using JobFunction = void (*) (void* context);
+
+    ParallelWorker();
+    ~ParallelWorker() override;
+
+    // Audio thread: asks for the thread to be started by the next startIfRequested()
+    void requestStart() noexcept { startRequested.store (true, std::memory_order_relaxed); }
+
+    // Thread lifetime — call from the message thread (timer / releaseResources), never from
+    // the audio thread. stop() also drops a pending start request.
+    void startIfRequested();
+    void stop();
+
+    // False on single-core machines or until the thread has been started
+    bool isAvailable() const noexcept { return available.load (std::memory_order_acquire); }
+
+    // Hands `job (context)` to the worker. Every launch() must be paired with a join()
+    // before anything the job touches is used again.
+    void launch (JobFunction job, void* context) noexcept;
+    void join() noexcept;
+
+private:
+    void run() override;
+
+    enum State : int { idle, pending, running, done };
+
+    std::atomic<int> state { idle };
+    JobFunction pendingJob = nullptr;
+    void* pendingContext = nullptr;
+
+    // Counts launches, including those join() took back, so the dozing worker can tell
+    // the processor is dispatching again
+    std::atomic<juce::uint32> launchCount { 0 };
+
+    juce::WaitableEvent exitEvent;   // Cuts a doze short when stop() is called
+    std::atomic<bool> startRequested { false };
+    std::atomic<bool> available { false };
+
+    JUCE_DECLARE_NON_COPYABLE (ParallelWorker)
+};
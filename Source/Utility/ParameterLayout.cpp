@@ -205,9 +205,98 @@ juce::AudioProcessorValueTreeState::ParameterLayout createParameterLayout()
         juce::AudioParameterFloatAttributes().withLabel("dB")
     ));
 
+    // Appended last so existing parameter indices (and host automation) stay put
+    globalGroup->addChild(std::make_unique<juce::AudioParameterChoice>(
+        juce::ParameterID{ParameterIDs::mix_law, 1},
+        "Mix Law",
+        juce::StringArray{"Linear", "Equal Power"},
+        0  // Default to "Linear" (matches earlier versions)
+    ));
+
+    // METER GROUP — processing load as a percentage of the block duration. Read-only
+    // outputs published by the processor for hosts and the test harness.
+    auto meterGroup = std::make_unique<juce::AudioProcessorParameterGroup>("meters", "Meters", "|");
+
+    const std::pair<const char*, const char*> loadMeters[] = {
+        { ParameterIDs::load_delay,       "Load Delay" },
+        { ParameterIDs::load_delay_peak,  "Load Delay Peak" },
+        { ParameterIDs::load_reverb,      "Load Reverb" },
+        { ParameterIDs::load_reverb_peak, "Load Reverb Peak" },
+        { ParameterIDs::load_mix,         "Load Mix" },
+        { ParameterIDs::load_mix_peak,    "Load Mix Peak" },
+        { ParameterIDs::load_total,       "Load Total" },
+        { ParameterIDs::load_total_peak,  "Load Total Peak" },
+    };
+
+    for (const auto& [id, name] : loadMeters)
+    {
+        meterGroup->addChild(std::make_unique<juce::AudioParameterFloat>(
+            juce::ParameterID{id, 1},
+            name,
+            juce::NormalisableRange<float>(0.0f, 100.0f, 0.01f),
+            0.0f,
+            juce::AudioParameterFloatAttributes().withLabel("%")
+                                                 .withAutomatable(false)
+                                                 .withCategory(juce::AudioProcessorParameter::otherMeter)
+        ));
+    }
+
+    // MORPH GROUP — A/B morph between two stored snapshots (see LogicTailAudioProcessor)
+    auto morphGroup = std::make_unique<juce::AudioProcessorParameterGroup>("morph", "Morph", "|");
+
+    morphGroup->addChild(std::make_unique<juce::AudioParameterFloat>(
+        juce::ParameterID{ParameterIDs::morph_amount, 1},
+        "Morph",
+        juce::NormalisableRange<float>(0.0f, 100.0f, 0.1f),
+        0.0f,
+        juce::AudioParameterFloatAttributes().withLabel("%")
+    ));
+
+    morphGroup->addChild(std::make_unique<juce::AudioParameterBool>(
+        juce::ParameterID{ParameterIDs::morph_enabled, 1},
+        "Morph On",
+        false
+    ));
+
+    // ENGINE GROUP — appended after every earlier group so existing indices stay put
+    auto engineGroup = std::make_unique<juce::AudioProcessorParameterGroup>("engine", "Engine", "|");
+
+    engineGroup->addChild(std::make_unique<juce::AudioParameterChoice>(
+        juce::ParameterID{ParameterIDs::reverb_quality, 1},
+        "Quality",
+        juce::StringArray{"Eco", "Standard", "Ultra"},
+        1  // Default to "Standard" (the topology of earlier versions)
+    ));
+
+    engineGroup->addChild(std::make_unique<juce::AudioParameterChoice>(
+        juce::ParameterID{ParameterIDs::reverb_algorithm, 1},
+        "Algorithm",
+        juce::StringArray{"Allpass", "FDN"},
+        0  // Default to "Allpass" (the reverb of earlier versions)
+    ));
+
+    engineGroup->addChild(std::make_unique<juce::AudioParameterChoice>(
+        juce::ParameterID{ParameterIDs::reverb_tail_rate, 1},
+        "Tail Rate",
+        juce::StringArray{"Full", "Half", "Quarter"},
+        0,  // Full rate; Half/Quarter only take effect at high sample rates
+        // A change re-prepares the reverb with processing suspended and drops the tail,
+        // so it is a setup choice rather than something to automate
+        juce::AudioParameterChoiceAttributes().withAutomatable(false)
+    ));
+
+    engineGroup->addChild(std::make_unique<juce::AudioParameterBool>(
+        juce::ParameterID{ParameterIDs::reverb_snapshot, 1},
+        "IR Snapshot",
+        false
+    ));
+
     layout.add(std::move(reverbGroup));
     layout.add(std::move(delayGroup));
     layout.add(std::move(globalGroup));
+    layout.add(std::move(meterGroup));
+    layout.add(std::move(morphGroup));
+    layout.add(std::move(engineGroup));
 
     return layout;
 }
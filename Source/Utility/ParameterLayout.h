@@ -32,6 +32,27 @@ namespace ParameterIDs {
     constexpr const char* global_mix = "global_mix";
     constexpr const char* input_gain = "input_gain";
     constexpr const char* output_gain = "output_gain";
+    constexpr const char* mix_law = "mix_law";
+
+    // METER parameters (read-only, written by the processor)
+    constexpr const char* load_delay = "load_delay";
+    constexpr const char* load_delay_peak = "load_delay_peak";
+    constexpr const char* load_reverb = "load_reverb";
+    constexpr const char* load_reverb_peak = "load_reverb_peak";
+    constexpr const char* load_mix = "load_mix";
+    constexpr const char* load_mix_peak = "load_mix_peak";
+    constexpr const char* load_total = "load_total";
+    constexpr const char* load_total_peak = "load_total_peak";
+
+    // MORPH parameters
+    constexpr const char* morph_amount = "morph_amount";
+    constexpr const char* morph_enabled = "morph_enabled";
+
+    // ENGINE parameters
+    constexpr const char* reverb_quality = "reverb_quality";
+    constexpr const char* reverb_algorithm = "reverb_algorithm";
+    constexpr const char* reverb_tail_rate = "reverb_tail_rate";
+    constexpr const char* reverb_snapshot = "reverb_snapshot";
 }
 
 juce::AudioProcessorValueTreeState::ParameterLayout createParameterLayout();
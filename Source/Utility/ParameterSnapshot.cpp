@@ -0,0 +1,176 @@
+#include "ParameterSnapshot.h"
+#include "ParameterLayout.h"
+
+ParameterCache::ParameterCache (juce::AudioProcessorValueTreeState& apvts)
+{
+    auto get = [&apvts] (const char* id)
+    {
+        auto* value = apvts.getRawParameterValue (id);
+        jassert (value != nullptr);   // ID missing from createParameterLayout()
+        return value;
+    };
+
+    gravity     = get (ParameterIDs::reverb_gravity);
+    size        = get (ParameterIDs::reverb_size);
+    preDelay    = get (ParameterIDs::reverb_predelay);
+    revFeedback = get (ParameterIDs::reverb_feedback);
+    revModDepth = get (ParameterIDs::reverb_mod_depth);
+    revModRate  = get (ParameterIDs::reverb_mod_rate);
+    loEQ        = get (ParameterIDs::reverb_lo);
+    hiEQ        = get (ParameterIDs::reverb_hi);
+    resonance   = get (ParameterIDs::reverb_resonance);
+    freeze      = get (ParameterIDs::reverb_freeze);
+    killDry     = get (ParameterIDs::reverb_kill_dry);
+
+    delTime     = get (ParameterIDs::delay_time);
+    delFeedback = get (ParameterIDs::delay_feedback);
+    delHP       = get (ParameterIDs::delay_hp);
+    delLP       = get (ParameterIDs::delay_lp);
+    delSync     = get (ParameterIDs::delay_sync);
+    delDivision = get (ParameterIDs::delay_division);
+    delPingPong = get (ParameterIDs::delay_pingpong);
+    delModRate  = get (ParameterIDs::delay_mod_rate);
+    delModDepth = get (ParameterIDs::delay_mod_depth);
+
+    routingMode = get (ParameterIDs::routing_mode);
+    balance     = get (ParameterIDs::parallel_balance);
+    mix         = get (ParameterIDs::global_mix);
+    inputGain   = get (ParameterIDs::input_gain);
+    outputGain  = get (ParameterIDs::output_gain);
+    mixLaw      = get (ParameterIDs::mix_law);
+
+    morph        = get (ParameterIDs::morph_amount);
+    morphEnabled = get (ParameterIDs::morph_enabled);
+
+    reverbQuality = get (ParameterIDs::reverb_quality);
+    reverbAlgorithm = get (ParameterIDs::reverb_algorithm);
+    tailRate = get (ParameterIDs::reverb_tail_rate);
+    reverbSnapshot = get (ParameterIDs::reverb_snapshot);
+}
+
+void ParameterCache::read (ParameterSnapshot& s) const noexcept
+{
+    constexpr auto order = std::memory_order_relaxed;
+
+    s.gravity     = gravity->load (order);
+    s.size        = size->load (order);
+    s.preDelay    = preDelay->load (order);
+    s.revFeedback = revFeedback->load (order);
+    s.revModDepth = revModDepth->load (order);
+    s.revModRate  = revModRate->load (order);
+    s.loEQ        = loEQ->load (order);
+    s.hiEQ        = hiEQ->load (order);
+    s.resonance   = resonance->load (order);
+    s.freeze      = freeze->load (order) > 0.5f;
+    s.killDry     = killDry->load (order) > 0.5f;
+
+    s.delTime     = delTime->load (order);
+    s.delFeedback = delFeedback->load (order);
+    s.delHP       = delHP->load (order);
+    s.delLP       = delLP->load (order);
+    s.delSync     = delSync->load (order) > 0.5f;
+    // AudioParameterChoice stores the selected index as a float directly
+    s.delDivision = static_cast<int> (delDivision->load (order));
+    s.delPingPong = delPingPong->load (order) > 0.5f;
+    s.delModRate  = delModRate->load (order);
+    s.delModDepth = delModDepth->load (order);
+
+    s.routingIdx  = static_cast<int> (routingMode->load (order));
+    s.balance     = balance->load (order);
+    s.mix         = mix->load (order);
+    s.inputGain   = inputGain->load (order);
+    s.outputGain  = outputGain->load (order);
+    s.mixLaw      = static_cast<int> (mixLaw->load (order));
+
+    s.morph        = morph->load (order);
+    s.morphEnabled = morphEnabled->load (order) > 0.5f;
+
+    s.reverbQuality = static_cast<int> (reverbQuality->load (order));
+    s.reverbAlgorithm = static_cast<int> (reverbAlgorithm->load (order));
+    s.tailRate = static_cast<int> (tailRate->load (order));
+    s.reverbSnapshot = reverbSnapshot->load (order) > 0.5f;
+}
+
+ParameterSnapshot makeParameterSnapshot (const std::function<float (const char* id)>& plainValueOf)
+{
+    ParameterSnapshot s;
+
+    s.gravity     = plainValueOf (ParameterIDs::reverb_gravity);
+    s.size        = plainValueOf (ParameterIDs::reverb_size);
+    s.preDelay    = plainValueOf (ParameterIDs::reverb_predelay);
+    s.revFeedback = plainValueOf (ParameterIDs::reverb_feedback);
+    s.revModDepth = plainValueOf (ParameterIDs::reverb_mod_depth);
+    s.revModRate  = plainValueOf (ParameterIDs::reverb_mod_rate);
+    s.loEQ        = plainValueOf (ParameterIDs::reverb_lo);
+    s.hiEQ        = plainValueOf (ParameterIDs::reverb_hi);
+    s.resonance   = plainValueOf (ParameterIDs::reverb_resonance);
+    s.freeze      = plainValueOf (ParameterIDs::reverb_freeze) > 0.5f;
+    s.killDry     = plainValueOf (ParameterIDs::reverb_kill_dry) > 0.5f;
+
+    s.delTime     = plainValueOf (ParameterIDs::delay_time);
+    s.delFeedback = plainValueOf (ParameterIDs::delay_feedback);
+    s.delHP       = plainValueOf (ParameterIDs::delay_hp);
+    s.delLP       = plainValueOf (ParameterIDs::delay_lp);
+    s.delSync     = plainValueOf (ParameterIDs::delay_sync) > 0.5f;
+    s.delDivision = juce::roundToInt (plainValueOf (ParameterIDs::delay_division));
+    s.delPingPong = plainValueOf (ParameterIDs::delay_pingpong) > 0.5f;
+    s.delModRate  = plainValueOf (ParameterIDs::delay_mod_rate);
+    s.delModDepth = plainValueOf (ParameterIDs::delay_mod_depth);
+
+    s.routingIdx  = juce::roundToInt (plainValueOf (ParameterIDs::routing_mode));
+    s.balance     = plainValueOf (ParameterIDs::parallel_balance);
+    s.mix         = plainValueOf (ParameterIDs::global_mix);
+    s.inputGain   = plainValueOf (ParameterIDs::input_gain);
+    s.outputGain  = plainValueOf (ParameterIDs::output_gain);
+    s.mixLaw      = juce::roundToInt (plainValueOf (ParameterIDs::mix_law));
+
+    s.morph        = plainValueOf (ParameterIDs::morph_amount);
+    s.morphEnabled = plainValueOf (ParameterIDs::morph_enabled) > 0.5f;
+
+    s.reverbQuality = juce::roundToInt (plainValueOf (ParameterIDs::reverb_quality));
+    s.reverbAlgorithm = juce::roundToInt (plainValueOf (ParameterIDs::reverb_algorithm));
+    s.tailRate = juce::roundToInt (plainValueOf (ParameterIDs::reverb_tail_rate));
+    s.reverbSnapshot = plainValueOf (ParameterIDs::reverb_snapshot) > 0.5f;
+    return s;
+}
+
+ParameterSnapshot interpolateSnapshots (const ParameterSnapshot& a, const ParameterSnapshot& b, float t) noexcept
+{
+    auto lerp = [t] (float x, float y) { return x + t * (y - x); };
+
+    // Frequencies and rates move evenly on a log axis
+    auto logLerp = [t, &lerp] (float x, float y)
+    {
+        return (x > 0.0f && y > 0.0f) ? x * std::pow (y / x, t) : lerp (x, y);
+    };
+
+    const auto& nearest = t < 0.5f ? a : b;
+    ParameterSnapshot s = nearest;
+
+    s.gravity     = lerp (a.gravity, b.gravity);
+    s.size        = lerp (a.size, b.size);
+    s.preDelay    = lerp (a.preDelay, b.preDelay);
+    s.revFeedback = lerp (a.revFeedback, b.revFeedback);
+    s.revModDepth = lerp (a.revModDepth, b.revModDepth);
+    s.revModRate  = logLerp (a.revModRate, b.revModRate);
+    s.loEQ        = lerp (a.loEQ, b.loEQ);
+    s.hiEQ        = lerp (a.hiEQ, b.hiEQ);
+    s.resonance   = lerp (a.resonance, b.resonance);
+
+    // Synced delay times come from the division, which switches with `nearest`
+    s.delTime     = lerp (a.delTime, b.delTime);
+    s.delFeedback = lerp (a.delFeedback, b.delFeedback);
+    s.delHP       = logLerp (a.delHP, b.delHP);
+    s.delLP       = logLerp (a.delLP, b.delLP);
+    s.delModRate  = logLerp (a.delModRate, b.delModRate);
+    s.delModDepth = lerp (a.delModDepth, b.delModDepth);
+
+    s.balance     = lerp (a.balance, b.balance);
+    s.mix         = lerp (a.mix, b.mix);
+    s.inputGain   = lerp (a.inputGain, b.inputGain);
+    s.outputGain  = lerp (a.outputGain, b.outputGain);
+
+    s.morph        = a.morph;
+    s.morphEnabled = a.morphEnabled;
+    return s;
+}
@@ -0,0 +1,107 @@
+#pragma once
+#include <JuceHeader.h>
+
+// Plain copy of every parameter value for one processBlock call.
+// Values are in their natural units (ms, %, dB, Hz) exactly as the APVTS stores them.
+struct ParameterSnapshot
+{
+    // Reverb
+    float gravity     = 0.0f;
+    float size        = 0.0f;
+    float preDelay    = 0.0f;
+    float revFeedback = 0.0f;
+    float revModDepth = 0.0f;
+    float revModRate  = 0.0f;
+    float loEQ        = 0.0f;
+    float hiEQ        = 0.0f;
+    float resonance   = 0.0f;
+    bool  freeze      = false;
+    bool  killDry     = false;
+
+    // Delay
+    float delTime     = 0.0f;
+    float delFeedback = 0.0f;
+    float delHP       = 0.0f;
+    float delLP       = 0.0f;
+    bool  delSync     = false;
+    int   delDivision = 0;
+    bool  delPingPong = false;
+    float delModRate  = 0.0f;
+    float delModDepth = 0.0f;
+
+    // Global
+    int   routingIdx  = 0;
+    float balance     = 0.0f;   // percent
+    float mix         = 0.0f;   // percent
+    float inputGain   = 0.0f;   // dB
+    float outputGain  = 0.0f;   // dB
+    int   mixLaw      = 0;      // 0 = linear, 1 = equal power
+
+    // Morph
+    float morph        = 0.0f;  // percent, A → B
+    bool  morphEnabled = false;
+
+    // Engine
+    int   reverbQuality = 1;        // ReverbTiers::Quality
+    int   reverbAlgorithm = 0;      // ReverbSection::Algorithm
+    int   tailRate = 0;             // ReverbSection::TailRate (applied from the message thread)
+    bool  reverbSnapshot = false;   // Convolve with a rendered impulse response while static
+};
+
+// Builds a snapshot from plain parameter values looked up by ID (message thread)
+ParameterSnapshot makeParameterSnapshot (const std::function<float (const char* id)>& plainValueOf);
+
+// Blend of two snapshots for morphing (t = 0 → a, t = 1 → b). Continuous values are
+// interpolated (frequencies geometrically), switches and choices flip at the midpoint.
+// The morph controls themselves are taken from `a`.
+ParameterSnapshot interpolateSnapshots (const ParameterSnapshot& a, const ParameterSnapshot& b, float t) noexcept;
+
+// Resolves the APVTS atomics once so the audio thread never does string lookups.
+class ParameterCache
+{
+public:
+    explicit ParameterCache (juce::AudioProcessorValueTreeState& apvts);
+
+    // Lock-free: one relaxed atomic load per parameter
+    void read (ParameterSnapshot& snapshot) const noexcept;
+
+private:
+    std::atomic<float>* gravity     = nullptr;
+    std::atomic<float>* size        = nullptr;
+    std::atomic<float>* preDelay    = nullptr;
+    std::atomic<float>* revFeedback = nullptr;
+    std::atomic<float>* revModDepth = nullptr;
+    std::atomic<float>* revModRate  = nullptr;
+    std::atomic<float>* loEQ        = nullptr;
+    std::atomic<float>* hiEQ        = nullptr;
+    std::atomic<float>* resonance   = nullptr;
+    std::atomic<float>* freeze      = nullptr;
+    std::atomic<float>* killDry     = nullptr;
+
+    std::atomic<float>* delTime     = nullptr;
+    std::atomic<float>* delFeedback = nullptr;
+    std::atomic<float>* delHP       = nullptr;
+    std::atomic<float>* delLP       = nullptr;
+    std::atomic<float>* delSync     = nullptr;
+    std::atomic<float>* delDivision = nullptr;
+    std::atomic<float>* delPingPong = nullptr;
+    std::atomic<float>* delModRate  = nullptr;
+    std::atomic<float>* delModDepth = nullptr;
+
+    std::atomic<float>* routingMode = nullptr;
+    std::atomic<float>* balance     = nullptr;
+    std::atomic<float>* mix         = nullptr;
+    std::atomic<float>* inputGain   = nullptr;
+    std::atomic<float>* outputGain  = nullptr;
+    std::atomic<float>* mixLaw      = nullptr;
+
+    std::atomic<float>* morph        = nullptr;
+    std::atomic<float>* morphEnabled = nullptr;
+
+    std::atomic<float>* reverbQuality = nullptr;
+    std::atomic<float>* reverbAlgorithm = nullptr;
+    std::atomic<float>* tailRate = nullptr;
+    std::atomic<float>* reverbSnapshot = nullptr;
+
+    JUCE_DECLARE_NON_COPYABLE (ParameterCache)
+};
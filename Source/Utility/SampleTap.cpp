@@ -0,0 +1,28 @@
+#include "SampleTap.h"
+
+template <typename SampleType>
+void SampleTap::write (const juce::AudioBuffer<SampleType>& buffer) noexcept
+{
+    if (! active.load (std::memory_order_relaxed))
+        return;
+
+    const int numSamples = buffer.getNumSamples();
+    const auto* left  = buffer.getReadPointer (0);
+    const auto* right = buffer.getReadPointer (buffer.getNumChannels() > 1 ? 1 : 0);
+
+    ring.pushGenerated (numSamples, [left, right] (int i)
+    {
+        return static_cast<float> ((left[i] + right[i]) * SampleType (0.5));
+    });
+}
+
+void SampleTap::setActive (bool shouldBeActive) noexcept
+{
+    if (shouldBeActive)
+        ring.discardAll();
+
+    active.store (shouldBeActive, std::memory_order_relaxed);
+}
+
+template void SampleTap::write<float> (const juce::AudioBuffer<float>&) noexcept;
+template void SampleTap::write<double> (const juce::AudioBuffer<double>&) noexcept;
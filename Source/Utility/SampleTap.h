@@ -0,0 +1,29 @@
+#pragma once
+#include <JuceHeader.h>
+#include "SpscRing.h"
+
+// Mono sample tap from the audio thread to one analysis thread.
+//
+// While inactive (no consumer running) write() returns immediately. While active it
+// costs one downmixing copy into a wait-free SPSC ring; blocks that do not fit are
+// dropped rather than waited for.
+class SampleTap
+{
+public:
+    // Message thread, before processing starts
+    void prepare (double newSampleRate) { sampleRate.store (newSampleRate, std::memory_order_relaxed); }
+
+    // Audio thread
+    template <typename SampleType>
+    void write (const juce::AudioBuffer<SampleType>& buffer) noexcept;
+
+    // Consumer thread. Activating drops anything left over from a previous consumer.
+    void setActive (bool shouldBeActive) noexcept;
+    int read (float* dest, int maxSamples) noexcept { return ring.pop (dest, maxSamples); }
+    double getSampleRate() const noexcept { return sampleRate.load (std::memory_order_relaxed); }
+
+private:
+    std::atomic<bool> active { false };
+    std::atomic<double> sampleRate { 44100.0 };
+    SpscRing<float, 32768> ring;
+};
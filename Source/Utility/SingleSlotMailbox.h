@@ -0,0 +1,53 @@
+#pragma once
+#include <JuceHeader.h>
+
+// Hands the latest value of a plain type from one non-realtime writer to the audio thread.
+//
+// The slot is preallocated; post() overwrites whatever has not been picked up yet, and
+// the audio side never blocks or allocates — it only claims the slot with one CAS. The
+// writer may briefly spin while the reader holds the slot (a copy of T at most).
+template <typename T>
+class SingleSlotMailbox
+{
+public:
+    // Writer side (message thread / state loading)
+    void post (const T& value) noexcept
+    {
+        for (;;)
+        {
+            int expected = empty;
+            if (state.compare_exchange_weak (expected, writing, std::memory_order_acquire))
+                break;
+
+            expected = ready;
+            if (state.compare_exchange_weak (expected, writing, std::memory_order_acquire))
+                break;
+
+            std::this_thread::yield();   // Reader is busy with the slot
+        }
+
+        slot = value;
+        state.store (ready, std::memory_order_release);
+    }
+
+    // Reader side (audio thread). Calls `consume (const T&)` on the pending value if
+    // there is one; the value is discarded when it returns true and kept for the
+    // next call otherwise. Returns true if a value was consumed.
+    template <typename Consumer>
+    bool consumeIf (Consumer&& consume) noexcept
+    {
+        int expected = ready;
+        if (! state.compare_exchange_strong (expected, reading, std::memory_order_acquire))
+            return false;
+
+        const bool consumed = consume (static_cast<const T&> (slot));
+        state.store (consumed ? empty : ready, std::memory_order_release);
+        return consumed;
+    }
+
+private:
+    enum State : int { empty, writing, ready, reading };
+
+    std::atomic<int> state { empty };
+    T slot {};
+};
@@ -0,0 +1,92 @@
+#pragma once
+#include <JuceHeader.h>
+#include <array>
+
+// Wait-free single-producer / single-consumer ring of trivially copyable items.
+//
+// Storage is fixed at compile time, so neither side ever allocates or locks. The
+// producer (audio thread) drops items when the ring is full instead of waiting; the
+// consumer (GUI / analysis thread) reads whatever has been published.
+template <typename T, int Capacity>
+class SpscRing
+{
+public:
+    static_assert ((Capacity & (Capacity - 1)) == 0, "Capacity must be a power of two");
+    static_assert (std::is_trivially_copyable_v<T>, "Items are copied without constructors");
+
+    // Producer side. Returns false (and writes nothing) if there is no room.
+    bool push (const T& item) noexcept
+    {
+        const auto write = writeIndex.load (std::memory_order_relaxed);
+        if (write - readIndex.load (std::memory_order_acquire) == static_cast<juce::uint32> (Capacity))
+            return false;
+
+        slots[write & kMask] = item;
+        writeIndex.store (write + 1, std::memory_order_release);
+        return true;
+    }
+
+    // Producer side, all or nothing
+    bool push (const T* items, int count) noexcept
+    {
+        return pushGenerated (count, [items] (int i) { return items[i]; });
+    }
+
+    // Producer side, all or nothing: item i is produced by itemAt (i), written straight
+    // into the ring (saves a staging copy when items are computed on the fly)
+    template <typename Generator>
+    bool pushGenerated (int count, Generator&& itemAt) noexcept
+    {
+        const auto write = writeIndex.load (std::memory_order_relaxed);
+        const auto used  = write - readIndex.load (std::memory_order_acquire);
+        if (count < 0 || static_cast<juce::uint32> (count) > static_cast<juce::uint32> (Capacity) - used)
+            return false;
+
+        for (int i = 0; i < count; ++i)
+            slots[(write + static_cast<juce::uint32> (i)) & kMask] = itemAt (i);
+
+        writeIndex.store (write + static_cast<juce::uint32> (count), std::memory_order_release);
+        return true;
+    }
+
+    // Consumer side. Returns false if the ring is empty.
+    bool pop (T& item) noexcept
+    {
+        const auto read = readIndex.load (std::memory_order_relaxed);
+        if (read == writeIndex.load (std::memory_order_acquire))
+            return false;
+
+        item = slots[read & kMask];
+        readIndex.store (read + 1, std::memory_order_release);
+        return true;
+    }
+
+    // Consumer side. Reads up to maxCount items, returns how many were read.
+    int pop (T* items, int maxCount) noexcept
+    {
+        const auto read = readIndex.load (std::memory_order_relaxed);
+        const auto available = static_cast<int> (writeIndex.load (std::memory_order_acquire) - read);
+        const int count = juce::jmin (available, maxCount);
+
+        for (int i = 0; i < count; ++i)
+            items[i] = slots[(read + static_cast<juce::uint32> (i)) & kMask];
+
+        readIndex.store (read + static_cast<juce::uint32> (count), std::memory_order_release);
+        return count;
+    }
+
+    // Consumer side: drops everything published so far
+    void discardAll() noexcept
+    {
+        readIndex.store (writeIndex.load (std::memory_order_acquire), std::memory_order_release);
+    }
+
+private:
+    static constexpr juce::uint32 kMask = static_cast<juce::uint32> (Capacity - 1);
+
+    std::array<T, Capacity> slots {};
+
+    // Kept on separate cache lines so producer and consumer do not false-share
+    alignas (64) std::atomic<juce::uint32> writeIndex { 0 };
+    alignas (64) std::atomic<juce::uint32> readIndex { 0 };
+};
@@ -0,0 +1,156 @@
+#include "StateSerializer.h"
+
+namespace
+{
+    // Meter outputs are written by the processor and never part of a preset
+    bool isStateParameter (const juce::AudioProcessorParameter& p)
+    {
+        switch (p.getCategory())
+        {
+            case juce::AudioProcessorParameter::genericParameter:
+            case juce::AudioProcessorParameter::inputGain:
+            case juce::AudioProcessorParameter::outputGain:
+                return true;
+            default:
+                return false;
+        }
+    }
+
+    const StateSerializer::ParameterValue* findValue (const StateSerializer::ParameterValues& values,
+                                                      const juce::String& id)
+    {
+        for (const auto& entry : values)
+            if (entry.id == id)
+                return &entry;
+
+        return nullptr;
+    }
+
+    void writeValues (juce::MemoryOutputStream& stream, const StateSerializer::ParameterValues& values)
+    {
+        stream.writeInt (static_cast<int> (values.size()));
+
+        for (const auto& entry : values)
+        {
+            stream.writeString (entry.id);
+            stream.writeFloat (entry.value);
+        }
+    }
+
+    // Smallest entry: an empty ID (its terminating zero) and the value
+    constexpr juce::int64 kMinEntryBytes = 1 + sizeof (float);
+
+    // False on a list that is cut short or whose count does not fit in the data, so
+    // corrupt state never reaches the reserve() below
+    bool readValues (juce::MemoryInputStream& stream, StateSerializer::ParameterValues& values)
+    {
+        values.clear();
+
+        if (stream.getNumBytesRemaining() < static_cast<juce::int64> (sizeof (int)))
+            return false;
+
+        const int count = stream.readInt();
+        if (count < 0 || count > stream.getNumBytesRemaining() / kMinEntryBytes)
+            return false;
+
+        values.reserve (static_cast<size_t> (count));
+
+        for (int i = 0; i < count; ++i)
+        {
+            if (stream.getNumBytesRemaining() < kMinEntryBytes)
+                return false;
+
+            StateSerializer::ParameterValue entry;
+            entry.id = stream.readString();
+
+            if (stream.getNumBytesRemaining() < static_cast<juce::int64> (sizeof (float)))
+                return false;
+
+            entry.value = stream.readFloat();
+            values.push_back (std::move (entry));
+        }
+
+        return true;
+    }
+}
+
+namespace StateSerializer
+{
+    ParameterValues capture (juce::AudioProcessorValueTreeState& apvts)
+    {
+        ParameterValues values;
+
+        for (auto* p : apvts.processor.getParameters())
+            if (auto* ranged = dynamic_cast<juce::RangedAudioParameter*> (p))
+                if (isStateParameter (*ranged))
+                    values.push_back ({ ranged->getParameterID(), ranged->convertFrom0to1 (ranged->getValue()) });
+
+        return values;
+    }
+
+    void write (juce::AudioProcessorValueTreeState& apvts, const MorphSlotValues& morphSlots,
+                juce::MemoryBlock& destData)
+    {
+        juce::MemoryOutputStream stream (destData, false);
+        stream.writeInt (kMagic);
+        stream.writeInt (kVersion);
+
+        writeValues (stream, capture (apvts));
+
+        for (const auto& slot : morphSlots)
+            writeValues (stream, slot);
+    }
+
+    bool read (const void* data, int sizeInBytes, ParameterValues& values, MorphSlotValues& morphSlots)
+    {
+        if (data == nullptr || sizeInBytes < 12)
+            return false;
+
+        juce::MemoryInputStream stream (data, static_cast<size_t> (sizeInBytes), false);
+        if (stream.readInt() != kMagic)
+            return false;
+
+        // Newer versions only ever append fields, so anything from version 1 up loads
+        const int version = stream.readInt();
+        if (version < 1 || ! readValues (stream, values))
+            return false;
+
+        // A version 2 state always carries both slot lists
+        for (auto& slot : morphSlots)
+        {
+            slot.clear();
+            if (version >= 2 && ! readValues (stream, slot))
+                return false;
+        }
+
+        return true;
+    }
+
+    void apply (juce::AudioProcessorValueTreeState& apvts, const ParameterValues& values)
+    {
+        for (auto* p : apvts.processor.getParameters())
+        {
+            auto* ranged = dynamic_cast<juce::RangedAudioParameter*> (p);
+            if (ranged == nullptr || ! isStateParameter (*ranged))
+                continue;
+
+            const auto* entry = findValue (values, ranged->getParameterID());
+            const float normalised = entry != nullptr ? ranged->convertTo0to1 (entry->value)
+                                                      : ranged->getDefaultValue();
+
+            // As apvts.replaceState() does: the APVTS and its attachments follow, but no
+            // automation or edit events reach the host for a recalled session
+            if (normalised != ranged->getValue())
+            {
+                ranged->setValue (normalised);
+                ranged->sendValueChangedMessageToListeners (normalised);
+            }
+        }
+    }
+
+    float find (const ParameterValues& values, const juce::String& id, float fallback)
+    {
+        const auto* entry = findValue (values, id);
+        return entry != nullptr ? entry->value : fallback;
+    }
+}
@@ -0,0 +1,46 @@
+#pragma once
+#include <JuceHeader.h>
+#include <array>
+
+// Compact binary plugin state.
+//
+// Layout (little endian): magic, version, then a parameter list — a count followed by
+// one (parameter ID string, plain value float) pair per parameter. Parameters are keyed
+// by ID so reordering or adding parameters keeps old states loadable; IDs missing from
+// a state fall back to their default value. States that do not start with the magic
+// (sessions saved before this format) are left to the XML path.
+//
+// Version 2 appends the two morph snapshots (A, B), each as a parameter list; an empty
+// list means the slot was never stored.
+namespace StateSerializer
+{
+    constexpr int kMagic   = 0x5453544c;   // "LTST"
+    constexpr int kVersion = 2;
+
+    struct ParameterValue
+    {
+        juce::String id;
+        float value = 0.0f;   // Plain (denormalised) value
+    };
+
+    using ParameterValues = std::vector<ParameterValue>;
+    using MorphSlotValues = std::array<ParameterValues, 2>;
+
+    // Current value of every ranged parameter of the APVTS except the read-only meters
+    ParameterValues capture (juce::AudioProcessorValueTreeState& apvts);
+
+    void write (juce::AudioProcessorValueTreeState& apvts, const MorphSlotValues& morphSlots,
+                juce::MemoryBlock& destData);
+
+    // Parses a binary state. Returns false if the data is not in this format, or is cut
+    // short or corrupt.
+    bool read (const void* data, int sizeInBytes, ParameterValues& values, MorphSlotValues& morphSlots);
+
+    // Sets every parameter from `values` (defaults for IDs not present). Parameter
+    // listeners hear of the change; the host does not (it reads the values back itself
+    // after setStateInformation()).
+    void apply (juce::AudioProcessorValueTreeState& apvts, const ParameterValues& values);
+
+    // Plain value for `id` from `values`, or `fallback` if the state does not contain it
+    float find (const ParameterValues& values, const juce::String& id, float fallback);
+}
@@ -8,7 +8,10 @@ param([switch]$Fresh)
 #  12  Tempo Sync   13  Division     14  Feedback (delay)  15  Ping Pong
 #  16  Mod Rate (delay)  17  Mod Depth (delay)  18  HP Filter  19  LP Filter
 #  20  Routing      21  Balance      22  Mix           23  Input
-#  24  Output       25  Bypass
+#  24  Output       25  Mix Law
+#  26-33  Load Delay/Reverb/Mix/Total (+ Peak) — read-only meters, reported in load.json
+#  34  Morph        35  Morph On      36  Quality      37  Algorithm
+#  38  Tail Rate    39  IR Snapshot   40  Bypass
 # Duplicate display names "Feedback", "Mod Rate", "Mod Depth" are disambiguated by index
 # in test case JSON files (paramsByIndex). Run with -Fresh to re-check after plugin changes.
 
@@ -82,6 +85,12 @@ function Invoke-Case {  # approved verb: Invoke
         return
     }
 
+    $loadFile = Join-Path $outDir "load.json"
+    if (Test-Path $loadFile) {
+        $load = Get-Content $loadFile | ConvertFrom-Json
+        Write-Host ("  load: total {0:N1} % avg, {1:N1} % peak" -f $load.'Load Total', $load.'Load Total Peak') -ForegroundColor DarkGray
+    }
+
     $wetWav = (Get-ChildItem $outDir -Filter "*.wav" -ErrorAction SilentlyContinue |
                Select-Object -First 1).FullName
     if (-not $wetWav) {
@@ -0,0 +1,107 @@
+// Checks FastMath::tanh against std::tanh over the input range the reverb can produce,
+// holding it to the error bounds documented in FastMath.h. Exits non-zero on failure.
+
+#include "FastMath.h"
+
+#include <cmath>
+#include <iostream>
+#include <limits>
+
+namespace
+{
+constexpr double kSweepLimit = 40.0;
+constexpr double kSweepStep = 1.0e-4;
+
+// Documented in FastMath.h
+constexpr double kMaxErrorOverall = 6.8e-6;
+constexpr double kInnerRange = 2.0;
+constexpr double kMaxErrorInner = 2.1e-12;
+
+// Rounding of a result below 1 in magnitude: up to 2 ulp
+template <typename T>
+double roundingOf()
+{
+    return 2.0 * static_cast<double>(std::numeric_limits<T>::epsilon());
+}
+
+template <typename T>
+bool checkTanh(const char* typeName)
+{
+    bool ok = true;
+    double worstOverall = 0.0, worstOverallAt = 0.0;
+    double worstInner = 0.0, worstInnerAt = 0.0;
+    const long steps = static_cast<long>(std::lround(kSweepLimit / kSweepStep));
+
+    for (long i = -steps; i <= steps; ++i)
+    {
+        const T x = static_cast<T>(static_cast<double>(i) * kSweepStep);
+        const T y = FastMath::tanh(x);
+        const double error = std::abs(static_cast<double>(y) - std::tanh(static_cast<double>(x)));
+
+        if (error > worstOverall)
+        {
+            worstOverall = error;
+            worstOverallAt = static_cast<double>(x);
+        }
+
+        if (std::abs(static_cast<double>(x)) < kInnerRange && error > worstInner)
+        {
+            worstInner = error;
+            worstInnerAt = static_cast<double>(x);
+        }
+
+        if (FastMath::tanh(-x) != -y)
+        {
+            std::cerr << typeName << ": not odd at x = " << static_cast<double>(x) << "\n";
+            ok = false;
+        }
+
+        if (std::abs(y) > T(1))
+        {
+            std::cerr << typeName << ": |tanh(" << static_cast<double>(x) << ")| exceeds 1\n";
+            ok = false;
+        }
+    }
+
+    std::cout << typeName << ": max error " << worstOverall << " at x = " << worstOverallAt
+              << ", for |x| < " << kInnerRange << " " << worstInner << " at x = " << worstInnerAt << "\n";
+
+    const double overallBound = kMaxErrorOverall + roundingOf<T>();
+    if (worstOverall > overallBound)
+    {
+        std::cerr << typeName << ": max error exceeds " << overallBound << "\n";
+        ok = false;
+    }
+
+    const double innerBound = kMaxErrorInner + roundingOf<T>();
+    if (worstInner > innerBound)
+    {
+        std::cerr << typeName << ": error for |x| < " << kInnerRange << " exceeds " << innerBound << "\n";
+        ok = false;
+    }
+
+    const T inf = std::numeric_limits<T>::infinity();
+    if (FastMath::tanh(inf) != T(1) || FastMath::tanh(-inf) != T(-1))
+    {
+        std::cerr << typeName << ": does not saturate to +-1 at +-inf\n";
+        ok = false;
+    }
+
+    return ok;
+}
+} // namespace
+
+int main()
+{
+    const bool floatOk = checkTanh<float>("float");
+    const bool doubleOk = checkTanh<double>("double");
+
+    if (!(floatOk && doubleOk))
+    {
+        std::cerr << "FastMath tests FAILED\n";
+        return 1;
+    }
+
+    std::cout << "FastMath tests passed\n";
+    return 0;
+}
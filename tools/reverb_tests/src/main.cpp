@@ -0,0 +1,540 @@
+// Runs the reverb engines offline and checks properties of their output that a listening
+// test would only catch by accident. Exits non-zero on failure.
+
+#include "FdnReverbEngine.h"
+#include "ReverbSection.h"
+
+#include <cmath>
+#include <iostream>
+#include <iterator>
+#include <random>
+#include <string>
+#include <vector>
+
+namespace
+{
+constexpr double kSampleRate = 48000.0;
+constexpr int kBlockSize = 256;
+constexpr int kNumChannels = 2;
+
+// FDN decay: a noise burst, then silence; the level late in the tail has to sit well
+// below the level early in it, and nothing may come near the output clamp
+constexpr double kBurstSeconds = 0.05;
+constexpr double kBurstLevel = 0.5;
+constexpr double kEarlyWindowSeconds = 0.5;
+constexpr double kLateWindowSeconds = 3.75;
+constexpr double kWindowSeconds = 0.25;
+constexpr double kMinDecayDb = 10.0;
+constexpr double kMaxPeak = 1.0;
+
+struct TailSettings
+{
+    float feedback, resonance, loEQ, hiEQ, size, gravity;
+};
+
+std::string describe(const TailSettings& s)
+{
+    return "Feedback " + std::to_string(s.feedback) + ", Resonance " + std::to_string(s.resonance)
+         + ", Lo " + std::to_string(s.loEQ) + " dB, Hi " + std::to_string(s.hiEQ)
+         + " dB, Size " + std::to_string(s.size) + ", Gravity " + std::to_string(s.gravity);
+}
+
+template <typename SampleType, int NumLines>
+bool checkFdnDecays(const char* name, const TailSettings& settings)
+{
+    FdnReverbEngine<SampleType, NumLines> engine;
+    engine.prepare(kSampleRate, kBlockSize, kNumChannels);
+    engine.setSize(settings.size);
+    engine.setGravity(settings.gravity);
+    engine.setFeedback(settings.feedback);
+    engine.setModulation(0.0f, 1.0f);
+    engine.setLoEQ(settings.loEQ);
+    engine.setHiEQ(settings.hiEQ);
+    engine.setResonance(settings.resonance);
+    engine.updateCoefficients();
+
+    const auto samplesFor = [](double seconds) { return static_cast<int>(seconds * kSampleRate); };
+    const int burstEnd = samplesFor(kBurstSeconds);
+    const int earlyStart = samplesFor(kEarlyWindowSeconds), lateStart = samplesFor(kLateWindowSeconds);
+    const int windowLength = samplesFor(kWindowSeconds);
+    const int totalLength = lateStart + windowLength;
+
+    std::mt19937 random(1234);
+    std::uniform_real_distribution<double> noise(-kBurstLevel, kBurstLevel);
+
+    juce::AudioBuffer<SampleType> block(kNumChannels, kBlockSize);
+    double earlyEnergy = 0.0, lateEnergy = 0.0, peak = 0.0;
+
+    for (int start = 0; start < totalLength; start += kBlockSize)
+    {
+        for (int ch = 0; ch < kNumChannels; ++ch)
+            for (int i = 0; i < kBlockSize; ++i)
+                block.setSample(ch, i, start + i < burstEnd ? static_cast<SampleType>(noise(random)) : SampleType(0));
+
+        engine.process(block);
+
+        for (int ch = 0; ch < kNumChannels; ++ch)
+        {
+            for (int i = 0; i < kBlockSize; ++i)
+            {
+                const int n = start + i;
+                const double y = static_cast<double>(block.getSample(ch, i));
+                peak = std::max(peak, std::abs(y));
+
+                if (n >= earlyStart && n < earlyStart + windowLength)
+                    earlyEnergy += y * y;
+                else if (n >= lateStart && n < lateStart + windowLength)
+                    lateEnergy += y * y;
+            }
+        }
+    }
+
+    bool ok = true;
+
+    if (!(peak <= kMaxPeak))
+    {
+        std::cerr << name << ": output peaks at " << peak << " with " << describe(settings) << "\n";
+        ok = false;
+    }
+
+    // A tail cut hard on every pass may already be silent in the early window
+    if (!(lateEnergy <= earlyEnergy * std::pow(10.0, -kMinDecayDb / 10.0)))
+    {
+        std::cerr << name << ": tail falls only " << 10.0 * std::log10(earlyEnergy / lateEnergy)
+                  << " dB with " << describe(settings) << "\n";
+        ok = false;
+    }
+
+    return ok;
+}
+
+// Resonance at full scale with the feedback loop at half and full decay, with the EQ
+// flat and cut (the cuts are where a resonant shelf overshoots), at the sizes and gravity
+// that bring a line's decay gain closest to 1
+template <typename SampleType, int NumLines>
+bool checkFdnResonanceDecays(const char* name)
+{
+    bool ok = true;
+
+    for (float feedback : { 50.0f, 100.0f })
+        for (float eq : { 0.0f, -12.0f })
+            for (float size : { 5.0f, 100.0f })
+                ok = checkFdnDecays<SampleType, NumLines>(name, { feedback, 100.0f, eq, eq, size, 100.0f }) && ok;
+
+    std::cout << name << ": resonant tails " << (ok ? "decay" : "FAILED") << "\n";
+    return ok;
+}
+
+// Snapshot null test: one section plays a captured snapshot, an identical one runs the
+// engine, both on the same noise. The difference is what the snapshot gets wrong — the
+// float convolution and the soft-clip's departure from linear at this level.
+constexpr int kNullBlocks = 400;
+constexpr int kNullInputBlocks = 200;
+constexpr double kNullInputLevel = 0.05;
+constexpr double kMaxNullResidualDb = -40.0;
+
+template <typename SampleType>
+bool checkSnapshotNulls(const char* name, double sampleRate, int tailRate, int algorithm, int quality)
+{
+    const int decimation = ReverbSection<SampleType>::decimationFor(sampleRate, tailRate);
+
+    ReverbSnapshotSettings settings;
+    settings.size = 40.0f;
+    settings.preDelay = 10.0f;
+    settings.feedback = 40.0f;
+    settings.hiEQ = -2.0f;
+    settings.quality = quality;
+    settings.algorithm = algorithm;
+
+    ReverbSection<SampleType> withSnapshot, withEngine;
+    for (auto* section : { &withSnapshot, &withEngine })
+    {
+        section->prepare(sampleRate, kBlockSize, kNumChannels, decimation);
+        section->setQuality(settings.quality);
+        section->setAlgorithm(settings.algorithm);
+        section->setGravity(settings.gravity);
+        section->setSize(settings.size);
+        section->setPreDelay(settings.preDelay);
+        section->setFeedback(settings.feedback);
+        section->setModulation(settings.modDepth, 1.0f);
+        section->setLoEQ(settings.loEQ);
+        section->setHiEQ(settings.hiEQ);
+        section->setResonance(settings.resonance);
+        section->setFreeze(settings.freeze);
+        section->updateCoefficients();
+        section->reset();
+    }
+
+    if (!withSnapshot.captureSnapshot(settings))
+    {
+        std::cerr << name << ": capture failed\n";
+        return false;
+    }
+    withSnapshot.setSnapshotEnabled(true);
+
+    std::mt19937 random(99);
+    std::uniform_real_distribution<double> noise(-kNullInputLevel, kNullInputLevel);
+
+    juce::AudioBuffer<SampleType> a(kNumChannels, kBlockSize), b(kNumChannels, kBlockSize);
+    double residualEnergy = 0.0, energy = 0.0;
+
+    for (int blockIndex = 0; blockIndex < kNullBlocks; ++blockIndex)
+    {
+        for (int i = 0; i < kBlockSize; ++i)
+        {
+            const double x = blockIndex < kNullInputBlocks ? noise(random) : 0.0;
+            for (int ch = 0; ch < kNumChannels; ++ch)
+                a.setSample(ch, i, static_cast<SampleType>(ch == 0 ? x : 0.5 * x));
+        }
+        b.makeCopyOf(a, true);
+
+        withSnapshot.process(a);
+        withEngine.process(b);
+
+        for (int ch = 0; ch < kNumChannels; ++ch)
+        {
+            for (int i = 0; i < kBlockSize; ++i)
+            {
+                const double difference = static_cast<double>(a.getSample(ch, i) - b.getSample(ch, i));
+                residualEnergy += difference * difference;
+                energy += static_cast<double>(b.getSample(ch, i)) * static_cast<double>(b.getSample(ch, i));
+            }
+        }
+    }
+
+    const double residualDb = 10.0 * std::log10(residualEnergy / energy);
+    const std::string description = std::string(name) + (algorithm == ReverbSection<SampleType>::fdn ? " FDN" : " allpass")
+                                  + " quality " + std::to_string(quality) + " at " + std::to_string(static_cast<int>(sampleRate))
+                                  + " Hz, decimation " + std::to_string(decimation);
+    std::cout << description << ": residual " << residualDb << " dB\n";
+
+    if (!(residualDb <= kMaxNullResidualDb))
+    {
+        std::cerr << description << ": residual exceeds " << kMaxNullResidualDb << " dB\n";
+        return false;
+    }
+
+    return true;
+}
+
+template <typename SampleType>
+bool checkSnapshotsNull(const char* name)
+{
+    using Section = ReverbSection<SampleType>;
+    bool ok = true;
+
+    for (double sampleRate : { 48000.0, 96000.0, 192000.0 })
+    {
+        const int tailRate = sampleRate > 100000.0 ? Section::quarterRate : Section::halfRate;
+        ok = checkSnapshotNulls<SampleType>(name, sampleRate, tailRate, Section::allpass, ReverbTiers::standard) && ok;
+        ok = checkSnapshotNulls<SampleType>(name, sampleRate, tailRate, Section::fdn, ReverbTiers::eco) && ok;
+        ok = checkSnapshotNulls<SampleType>(name, sampleRate, tailRate, Section::fdn, ReverbTiers::standard) && ok;
+    }
+
+    return ok;
+}
+
+// Snapshot convolution: a random response against noise in uneven blocks, checked against
+// direct convolution. The older partitions are summed across the calls of a partition,
+// so blocks that split partitions at odd points must give the same output as any other.
+constexpr int kConvolutionPartitions = 7;
+constexpr int kConvolutionSamples = 12 * ReverbSnapshot<float>::kMinPartitionSize;
+constexpr double kMaxConvolutionError = 1.0e-4;
+
+template <typename SampleType>
+bool checkSnapshotConvolves(const char* name)
+{
+    constexpr int partitionSize = ReverbSnapshot<SampleType>::kMinPartitionSize;
+
+    ReverbSnapshot<SampleType> snapshot;
+    snapshot.prepare(kSampleRate, partitionSize, kNumChannels);
+
+    std::mt19937 random(7);
+    std::uniform_real_distribution<double> noise(-1.0, 1.0);
+
+    // A response that ends partway through its last partition
+    const int length = kConvolutionPartitions * partitionSize - 100;
+    std::vector<std::vector<double>> response(kNumChannels, std::vector<double>(static_cast<size_t>(length)));
+    for (auto& channel : response)
+        for (size_t i = 0; i < channel.size(); ++i)
+            channel[i] = noise(random) * std::exp(-3.0 * static_cast<double>(i) / length);
+
+    typename ReverbSnapshot<SampleType>::Builder builder(snapshot, ReverbSnapshotSettings());
+    for (int start = 0; start < length; start += partitionSize)
+    {
+        const double* channels[kNumChannels];
+        for (int ch = 0; ch < kNumChannels; ++ch)
+            channels[ch] = response[static_cast<size_t>(ch)].data() + start;
+        builder.addPartition(channels, std::min(partitionSize, length - start), 1.0);
+    }
+
+    if (!snapshot.post(builder))
+    {
+        std::cerr << name << ": post failed\n";
+        return false;
+    }
+    snapshot.receive();
+
+    std::vector<float> input(static_cast<size_t>(kConvolutionSamples));
+    for (auto& x : input)
+        x = static_cast<float>(noise(random));
+
+    std::vector<std::vector<SampleType>> output(kNumChannels, std::vector<SampleType>(input.size(), SampleType(0)));
+    const int blockSizes[] = { 37, 1, 200, 512, 64, 129, 300 };
+    for (int done = 0, block = 0; done < kConvolutionSamples; ++block)
+    {
+        const int numSamples = std::min(blockSizes[block % static_cast<int>(std::size(blockSizes))], kConvolutionSamples - done);
+        SampleType* outputs[kNumChannels];
+        for (int ch = 0; ch < kNumChannels; ++ch)
+            outputs[ch] = output[static_cast<size_t>(ch)].data() + done;
+
+        snapshot.process(input.data() + done, false, outputs, kNumChannels, numSamples);
+        done += numSamples;
+    }
+
+    double worst = 0.0, peak = 0.0;
+    for (int ch = 0; ch < kNumChannels; ++ch)
+    {
+        const auto& h = response[static_cast<size_t>(ch)];
+        for (int n = 0; n < kConvolutionSamples; ++n)
+        {
+            double y = 0.0;
+            for (int i = 0; i < std::min(n + 1, length); ++i)
+                y += h[static_cast<size_t>(i)] * static_cast<double>(input[static_cast<size_t>(n - i)]);
+
+            worst = std::max(worst, std::abs(static_cast<double>(output[static_cast<size_t>(ch)][static_cast<size_t>(n)]) - y));
+            peak = std::max(peak, std::abs(y));
+        }
+    }
+
+    std::cout << name << ": convolution differs by " << worst / peak << " of peak\n";
+
+    if (!(worst <= kMaxConvolutionError * peak))
+    {
+        std::cerr << name << ": convolution departs from direct convolution\n";
+        return false;
+    }
+
+    return true;
+}
+
+// Engine switch: a noise burst, then silence, and a tier or algorithm change in the
+// silence. The tail already in the reverb has to carry on through the change rather
+// than stop, so the level just after it may only fall as far as the tail decays anyway.
+constexpr double kSwitchBurstSeconds = 0.3;
+constexpr double kSwitchAtSeconds = 0.5;
+constexpr double kSwitchWindowSeconds = 0.1;
+constexpr double kMaxSwitchDropDb = 20.0;
+
+template <typename SampleType>
+bool checkSwitchKeepsTail(const char* name, int fromAlgorithm, int fromQuality, int toAlgorithm, int toQuality)
+{
+    ReverbSection<SampleType> section;
+    section.prepare(kSampleRate, kBlockSize, kNumChannels);
+    section.setQuality(fromQuality);
+    section.setAlgorithm(fromAlgorithm);
+    section.setSize(50.0f);
+    section.setFeedback(60.0f);
+    section.setModulation(0.0f, 1.0f);
+    section.updateCoefficients();
+    section.reset();
+
+    const auto samplesFor = [](double seconds) { return static_cast<int>(seconds * kSampleRate); };
+    const int burstEnd = samplesFor(kSwitchBurstSeconds);
+    const int switchAt = samplesFor(kSwitchAtSeconds);
+    const int windowLength = samplesFor(kSwitchWindowSeconds);
+    const int afterStart = switchAt + samplesFor(ReverbSection<SampleType>::kSwitchFadeSeconds);
+    const int totalLength = afterStart + windowLength;
+
+    std::mt19937 random(4321);
+    std::uniform_real_distribution<double> noise(-kBurstLevel, kBurstLevel);
+
+    juce::AudioBuffer<SampleType> block(kNumChannels, kBlockSize);
+    double beforeEnergy = 0.0, afterEnergy = 0.0;
+    bool switched = false;
+
+    for (int start = 0; start < totalLength; start += kBlockSize)
+    {
+        if (!switched && start >= switchAt)
+        {
+            section.setQuality(toQuality);
+            section.setAlgorithm(toAlgorithm);
+            section.updateCoefficients();
+            switched = true;
+        }
+
+        for (int ch = 0; ch < kNumChannels; ++ch)
+            for (int i = 0; i < kBlockSize; ++i)
+                block.setSample(ch, i, start + i < burstEnd ? static_cast<SampleType>(noise(random)) : SampleType(0));
+
+        section.process(block);
+
+        for (int ch = 0; ch < kNumChannels; ++ch)
+        {
+            for (int i = 0; i < kBlockSize; ++i)
+            {
+                const int n = start + i;
+                const double y = static_cast<double>(block.getSample(ch, i));
+
+                if (n >= switchAt - windowLength && n < switchAt)
+                    beforeEnergy += y * y;
+                else if (n >= afterStart && n < afterStart + windowLength)
+                    afterEnergy += y * y;
+            }
+        }
+    }
+
+    const double dropDb = 10.0 * std::log10(beforeEnergy / afterEnergy);
+    std::cout << name << ": tail falls " << dropDb << " dB across the switch\n";
+
+    if (!(afterEnergy >= beforeEnergy * std::pow(10.0, -kMaxSwitchDropDb / 10.0)))
+    {
+        std::cerr << name << ": switch cuts the tail\n";
+        return false;
+    }
+
+    return true;
+}
+
+template <typename SampleType>
+bool checkSwitchesKeepTail(const char* name)
+{
+    using Section = ReverbSection<SampleType>;
+    const std::string prefix(name);
+    bool ok = true;
+
+    ok = checkSwitchKeepsTail<SampleType>((prefix + " standard to eco").c_str(),
+                                          Section::allpass, ReverbTiers::standard, Section::allpass, ReverbTiers::eco) && ok;
+    ok = checkSwitchKeepsTail<SampleType>((prefix + " allpass to FDN").c_str(),
+                                          Section::allpass, ReverbTiers::standard, Section::fdn, ReverbTiers::standard) && ok;
+    return ok;
+}
+// Wake-up: an engine put to sleep after a tail, woken two sleeping blocks later with its
+// lines still mostly uncleared, has to sound exactly like one that was reset, given the
+// same input and the same Size and Pre-delay moves after the wake-up (no modulation, so
+// the LFO phases do not matter). Anything left over from the old tail would show.
+constexpr int kWakeBlocks = 400;
+constexpr int kWakeMoveBlock = 40;
+constexpr double kMaxWakeDifference = 1.0e-12;
+
+template <typename Engine>
+void setUpForWake(Engine& engine)
+{
+    engine.prepare(kSampleRate, kBlockSize, kNumChannels);
+    engine.setSize(60.0f);
+    engine.setPreDelay(20.0f);
+    engine.setFeedback(50.0f);
+    engine.setModulation(0.0f, 1.0f);
+    engine.updateCoefficients();
+}
+
+template <typename SampleType>
+void fillNoise(juce::AudioBuffer<SampleType>& block, std::mt19937& random)
+{
+    std::uniform_real_distribution<double> noise(-kBurstLevel, kBurstLevel);
+    for (int ch = 0; ch < kNumChannels; ++ch)
+        for (int i = 0; i < kBlockSize; ++i)
+            block.setSample(ch, i, static_cast<SampleType>(noise(random)));
+}
+
+template <typename SampleType, typename Engine>
+bool checkWakeMatchesReset(const char* name)
+{
+    Engine woken, fresh;
+    setUpForWake(woken);
+    setUpForWake(fresh);
+
+    juce::AudioBuffer<SampleType> a(kNumChannels, kBlockSize), b(kNumChannels, kBlockSize);
+    std::mt19937 random(777);
+
+    // A tail, then silence until it sleeps and has cleared only the first two slices
+    for (int blockIndex = 0; blockIndex < 40; ++blockIndex)
+    {
+        fillNoise(a, random);
+        woken.process(a);
+    }
+
+    int sleepingBlocks = 0;
+    while (sleepingBlocks < 2)
+    {
+        a.clear();
+        woken.process(a);
+        if (woken.isSleeping())
+            ++sleepingBlocks;
+    }
+
+    // Size jumps at the wake-up, then both ramp Size and jump Pre-delay together
+    woken.setSize(100.0f);
+    fresh.setSize(100.0f);
+
+    double worst = 0.0, peak = 0.0;
+    for (int blockIndex = 0; blockIndex < kWakeBlocks; ++blockIndex)
+    {
+        if (blockIndex == kWakeMoveBlock)
+        {
+            for (auto* engine : { &woken, &fresh })
+            {
+                engine->setSize(30.0f);
+                engine->setPreDelay(200.0f);
+            }
+        }
+
+        if (blockIndex < kWakeBlocks / 2)
+            fillNoise(a, random);
+        else
+            a.clear();
+        b.makeCopyOf(a, true);
+
+        woken.process(a);
+        fresh.process(b);
+
+        for (int ch = 0; ch < kNumChannels; ++ch)
+        {
+            for (int i = 0; i < kBlockSize; ++i)
+            {
+                const double y = static_cast<double>(b.getSample(ch, i));
+                worst = std::max(worst, std::abs(static_cast<double>(a.getSample(ch, i)) - y));
+                peak = std::max(peak, std::abs(y));
+            }
+        }
+    }
+
+    std::cout << name << ": woken engine differs by " << worst << " (peak " << peak << ")\n";
+
+    if (!(worst <= kMaxWakeDifference))
+    {
+        std::cerr << name << ": woken engine replays its old tail\n";
+        return false;
+    }
+
+    return true;
+}
+} // namespace
+
+int main()
+{
+    bool ok = true;
+    ok = checkFdnResonanceDecays<float, 8>("FDN 8 float") && ok;
+    ok = checkFdnResonanceDecays<float, 16>("FDN 16 float") && ok;
+    ok = checkFdnResonanceDecays<double, 8>("FDN 8 double") && ok;
+    ok = checkFdnResonanceDecays<double, 16>("FDN 16 double") && ok;
+    ok = checkSnapshotsNull<float>("Snapshot float") && ok;
+    ok = checkSnapshotsNull<double>("Snapshot double") && ok;
+    ok = checkSnapshotConvolves<float>("Convolution float") && ok;
+    ok = checkSnapshotConvolves<double>("Convolution double") && ok;
+    ok = checkSwitchesKeepTail<float>("Switch float") && ok;
+    ok = checkSwitchesKeepTail<double>("Switch double") && ok;
+    ok = checkWakeMatchesReset<float, ReverbEngine<float, ReverbTiers::Standard>>("Wake allpass float") && ok;
+    ok = checkWakeMatchesReset<double, ReverbEngine<double, ReverbTiers::Ultra>>("Wake allpass double") && ok;
+    ok = checkWakeMatchesReset<float, FdnReverbEngine<float, 16>>("Wake FDN float") && ok;
+    ok = checkWakeMatchesReset<double, FdnReverbEngine<double, 8>>("Wake FDN double") && ok;
+
+    if (!ok)
+    {
+        std::cerr << "Reverb tests FAILED\n";
+        return 1;
+    }
+
+    std::cout << "Reverb tests passed\n";
+    return 0;
+}
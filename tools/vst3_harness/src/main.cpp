@@ -830,6 +830,25 @@ double computeCorrelation(const juce::AudioBuffer<float>& a, const juce::AudioBu
     return dot / std::sqrt(energyA * energyB);
 }
 
+// Reads the plugin's read-only "Load ..." meter parameters (normalised 0..1 = 0..100 %
+// of the block duration) into a JSON object keyed by parameter name
+juce::var collectLoadReport(juce::AudioPluginInstance& instance)
+{
+    juce::DynamicObject::Ptr report = new juce::DynamicObject();
+
+    for (auto* parameter : instance.getParameters())
+    {
+        if (parameter == nullptr)
+            continue;
+
+        const auto name = parameter->getName(256);
+        if (name.startsWith("Load "))
+            report->setProperty(name, static_cast<double>(parameter->getValue()) * 100.0);
+    }
+
+    return juce::var(report.get());
+}
+
 int runDumpParams(const OptionMap& options)
 {
     juce::String pluginPathText;
@@ -974,6 +993,9 @@ int runRender(const OptionMap& options)
         }
     }
 
+    // Read the load meters while the plugin is still prepared
+    const juce::var loadReport = collectLoadReport(*plugin);
+
     plugin->releaseResources();
 
     if (!ensureDirectory(outDir, error))
@@ -984,6 +1006,19 @@ int runRender(const OptionMap& options)
         return fail(error);
 
     std::cout << "Wrote: " << wetPath.getFullPathName() << "\n";
+
+    if (auto* loadObject = loadReport.getDynamicObject(); loadObject != nullptr && !loadObject->getProperties().isEmpty())
+    {
+        const juce::File loadPath = outDir.getChildFile("load.json");
+        const auto loadJson = juce::JSON::toString(
+            loadReport,
+            juce::JSON::FormatOptions().withSpacing(juce::JSON::Spacing::multiLine).withEncoding(juce::JSON::Encoding::ascii));
+
+        if (!loadPath.replaceWithText(loadJson))
+            return fail("Failed to write load JSON: " + loadPath.getFullPathName());
+
+        std::cout << "Wrote: " << loadPath.getFullPathName() << "\n";
+    }
     return 0;
 }
 